@@ -0,0 +1,140 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Implementação da gravação da população em segundo plano.
+ */
+
+#include "checkpoint.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../comum/profiler.h"
+#include "population_file.h"
+
+namespace {
+
+std::string historyPath(const std::string &path, int k) { return path + "." + std::to_string(k); }
+
+/** @brief Diretório que contém `path` ("." se não houver barra). */
+std::string directoryOf(const std::string &path) {
+    const size_t slash = path.find_last_of('/');
+    if (slash == std::string::npos) return ".";
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+} // namespace
+
+CheckpointWriter::CheckpointWriter(const std::string &path, int history)
+    : path(path), history(history), thread(&CheckpointWriter::run, this) {}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+void CheckpointWriter::submit(const std::vector<Individual> &population, int generation) {
+    PROFILE_SCOPE(CHECKPOINT);
+    std::unique_lock<std::mutex> lock(mutex);
+    // Serializa direto no buffer pendente: a thread de gravação só o lê depois de trocá-lo
+    // com `writing`, sob o mesmo mutex.
+    serializePopulation(population, generation, pending);
+    hasPending = true;
+    lock.unlock();
+    wake.notify_one();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [&] { return !hasPending && !busy; });
+}
+
+void CheckpointWriter::run() {
+    PROFILE_THREAD("checkpoint");
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&] { return hasPending || stopping; });
+        if (!hasPending) break; // Parada sem nada pendente.
+        pending.swap(writing);
+        hasPending = false;
+        busy = true;
+        lock.unlock();
+
+        {
+            PROFILE_SCOPE(CHECKPOINT);
+            writeFile(writing);
+        }
+
+        lock.lock();
+        busy = false;
+        if (!hasPending) idle.notify_all();
+    }
+    idle.notify_all();
+}
+
+bool CheckpointWriter::writeFile(const std::vector<char> &data) {
+    const std::string tmpPath = path + ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Erro ao salvar a populacao em " << tmpPath << "." << std::endl;
+        return false;
+    }
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        written += static_cast<size_t>(n);
+    }
+    bool ok = written == data.size() && ::fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    if (!ok) {
+        std::cerr << "Erro ao salvar a populacao em " << tmpPath << "." << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    // Histórico: o save atual continua no lugar (com um link em path.1) até o rename final.
+    if (history > 0 && ::access(path.c_str(), F_OK) == 0) {
+        std::remove(historyPath(path, history).c_str());
+        for (int k = history - 1; k >= 1; k--) {
+            std::rename(historyPath(path, k).c_str(), historyPath(path, k + 1).c_str());
+        }
+        if (::link(path.c_str(), historyPath(path, 1).c_str()) != 0) {
+            std::cerr << "AVISO: Nao foi possivel guardar o save anterior em " << historyPath(path, 1) << "." << std::endl;
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Erro ao substituir o save " << path << "." << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    // Garante que a nova entrada do diretório também chegou ao disco.
+    int dirFd = ::open(directoryOf(path).c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+    return true;
+}
+
+bool loadCheckpoint(std::vector<Individual> &population, const std::string &path, int history,
+                    int expectedSize, int numRules, int &generation) {
+    for (int k = 0; k <= history; k++) {
+        const std::string candidate = k == 0 ? path : historyPath(path, k);
+        if (::access(candidate.c_str(), F_OK) != 0) continue;
+        if (loadPopulation(population, candidate, expectedSize, numRules, &generation)) {
+            if (k > 0) std::cout << "AVISO: '" << path << "' nao pode ser lido; usando o save anterior '" << candidate << "'." << std::endl;
+            return true;
+        }
+    }
+    return false;
+}
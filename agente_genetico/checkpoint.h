@@ -0,0 +1,83 @@
+/**
+ * @file checkpoint.h
+ * @brief Gravação da população em segundo plano, atômica e com histórico.
+ * @details O laço de treinamento só serializa a população em um buffer contíguo (poucos
+ * milissegundos) e o entrega ao CheckpointWriter, que grava em uma thread própria:
+ *
+ * 1. escreve o buffer em `path.tmp` e chama fsync;
+ * 2. gira o histórico: `path.N` é apagado, `path.k` vira `path.k+1` e o save anterior
+ *    ganha um link `path.1`, de modo que `path` nunca deixa de existir;
+ * 3. renomeia `path.tmp` para `path` (atômico no mesmo sistema de arquivos) e faz fsync
+ *    do diretório.
+ *
+ * Uma queda em qualquer ponto deixa `path` inteiro (o save novo ou o anterior). Se a
+ * gravação anterior ainda estiver em andamento quando chega um novo checkpoint, só o mais
+ * recente fica na fila: o treinamento nunca espera pelo disco.
+ */
+
+#ifndef CAMPO_MINADO_CHECKPOINT_H
+#define CAMPO_MINADO_CHECKPOINT_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rules.h"
+
+/**
+ * @class CheckpointWriter
+ * @brief Thread de gravação dos checkpoints da população.
+ */
+class CheckpointWriter {
+public:
+    /**
+     * @param path Arquivo do save (ex: "populacao_regras.dat").
+     * @param history Número de saves anteriores mantidos como `path.1` ... `path.N`.
+     */
+    CheckpointWriter(const std::string &path, int history);
+
+    /** @brief Grava o checkpoint pendente, se houver, e encerra a thread. */
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    /**
+     * @brief Serializa `population` na thread que chama e agenda a gravação.
+     * @param generation Última geração concluída; a próxima execução continua da seguinte.
+     * @details Substitui um checkpoint ainda não gravado.
+     */
+    void submit(const std::vector<Individual> &population, int generation);
+
+    /** @brief Espera até que todos os checkpoints entregues tenham sido gravados. */
+    void flush();
+
+private:
+    void run();
+    bool writeFile(const std::vector<char> &data);
+
+    std::string path;
+    int history;
+
+    std::mutex mutex;
+    std::condition_variable wake;  // Novo checkpoint ou pedido de parada.
+    std::condition_variable idle;  // Nada pendente nem em gravação.
+    std::vector<char> pending;     // Próximo checkpoint a gravar.
+    std::vector<char> writing;     // Checkpoint em gravação (só a thread de gravação o usa).
+    bool hasPending = false;
+    bool busy = false;
+    bool stopping = false;
+    std::thread thread;
+};
+
+/**
+ * @brief Carrega o save mais recente que estiver íntegro: `path`, depois `path.1` ... `path.history`.
+ * @param generation Recebe a geração gravada no save carregado (ver readPopulation).
+ * @return true se algum deles foi carregado.
+ */
+bool loadCheckpoint(std::vector<Individual> &population, const std::string &path, int history,
+                    int expectedSize, int numRules, int &generation);
+
+#endif // CAMPO_MINADO_CHECKPOINT_H
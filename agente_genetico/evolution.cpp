@@ -0,0 +1,177 @@
+/**
+ * @file evolution.cpp
+ * @brief Criação, avaliação, seleção, crossover e mutação dos indivíduos.
+ */
+
+#include "evolution.h"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+// Menor e maior valor de cada campo do genoma (ver GeneField).
+constexpr int FIELD_RANGE[GENE_FIELDS][2] = {{0, 8}, {0, 8}, {0, 8}, {0, 1}, {0, 1}, {1, 2}, {1, 10}, {0, 1}};
+
+// Bit baixo dos nibbles comparados pela distância genética (todos menos GENE_PRIORITY).
+constexpr uint32_t DISTANCE_FIELDS = 0x11111111u & ~(1u << (4 * GENE_PRIORITY));
+
+/** @brief Marcas dos pontos de corte do crossover, reaproveitadas entre as chamadas da thread. */
+std::vector<char> &crossoverPoints() {
+    thread_local std::vector<char> points;
+    return points;
+}
+
+} // namespace
+
+Individual createRandomIndividual(int numRules, Xoshiro256 &rng) {
+    Individual ind;
+    ind.genome.resize(numRules);
+    std::uniform_int_distribution<> dis_num(0, 8);
+    std::uniform_int_distribution<> dis_hidden(0, 8);
+    std::uniform_int_distribution<> dis_flagged(0, 8);
+    std::uniform_int_distribution<> dis_bool(0, 1);
+    std::uniform_int_distribution<> dis_scope(1, 2);
+    std::uniform_int_distribution<> dis_priority(1, 10);
+
+    for(int i = 0; i < numRules; i++) {
+        Rule rule;
+        rule.numberCondition = dis_num(rng);
+        rule.hiddenCondition = dis_hidden(rng);
+        rule.flaggedCondition = dis_flagged(rng);
+        rule.nearEdge = dis_bool(rng);
+        rule.hasSpecificPattern = dis_bool(rng);
+        rule.extendedScope = dis_scope(rng);
+        rule.priority = dis_priority(rng);
+        rule.action = (dis_bool(rng) == 0) ? ACTION_REVEAL_HIDDEN : ACTION_PLACE_FLAG;
+        ind.genome[i] = packRule(rule);
+    }
+    compileRules(ind);
+    return ind;
+}
+
+ScenarioScore scoreScenario(int safeRevealed, int correctFlags, int minesRevealed, int actionsTaken, bool won) {
+    double score = safeRevealed;
+    score += correctFlags * 5.0;
+    score -= minesRevealed * 50.0;
+    score -= actionsTaken * 0.1;
+
+    if(won) {
+        score += 2000.0;
+    }
+
+    return {score, won};
+}
+
+ScenarioScore evaluateScenario(const Individual &ind, const Game &startBoard, uint64_t scenarioSeed, Game &game) {
+    game.loadState(startBoard);
+    Xoshiro256 rng(scenarioSeed);
+
+    int actionsTaken = 0;
+    bool changed = true;
+    while(!game.gameOver && !game.youWin && changed) {
+        changed = applyRules(ind, game);
+        if(changed) {
+            actionsTaken++;
+        }
+        if(!changed && !game.gameOver && !game.youWin) {
+            revealRandomCell(game, rng);
+            actionsTaken++;
+            changed = true;
+        }
+    }
+
+    // Os contadores do tabuleiro são mantidos a cada jogada; não é preciso varrer o grid.
+    return scoreScenario(game.revealedSafe, game.correctFlags, game.minesRevealed, actionsTaken, game.youWin);
+}
+
+ScenarioScore recordScenario(const Individual &ind, const Game &startBoard, uint64_t scenarioSeed, Game &game,
+                             std::vector<uint32_t> &moves) {
+    moves.clear();
+    game.moveLog = &moves;
+    const ScenarioScore result = evaluateScenario(ind, startBoard, scenarioSeed, game);
+    game.moveLog = nullptr;
+    return result;
+}
+
+double evaluateIndividual(const Individual &ind, const std::vector<Game> &startBoards, const std::vector<uint64_t> &scenarioSeeds,
+                          Game &game, int &wins) {
+    double totalScore = 0.0;
+    for(size_t g = 0; g < startBoards.size(); g++) {
+        ScenarioScore result = evaluateScenario(ind, startBoards[g], scenarioSeeds[g], game);
+        totalScore += result.score;
+        if (result.won) wins++;
+    }
+    return totalScore / startBoards.size();
+}
+
+double calculateGeneticDistance(const Individual &a, const Individual &b) {
+    const size_t numRules = a.genome.size();
+    int distance = 0;
+    for(size_t i = 0; i < numRules; i++) {
+        // Um bit por nibble diferente; a prioridade não entra na distância.
+        uint32_t diff = a.genome[i] ^ b.genome[i];
+        diff |= diff >> 2;
+        diff |= diff >> 1;
+        distance += __builtin_popcount(diff & DISTANCE_FIELDS);
+    }
+    return static_cast<double>(distance) / (numRules * 7.0); // Normalizado
+}
+
+int tournamentSelection(const std::vector<Individual> &pop, int tournamentSize, Xoshiro256 &rng) {
+    std::uniform_int_distribution<> dis(0, static_cast<int>(pop.size()) - 1);
+    int best = dis(rng);
+
+    for(int i = 1; i < tournamentSize; i++) {
+        int competitor = dis(rng);
+        if(pop[competitor].fitness > pop[best].fitness) {
+            best = competitor;
+        }
+    }
+    return best;
+}
+
+void crossover(const Individual &p1, const Individual &p2, Individual &o1, Individual &o2, Xoshiro256 &rng) {
+    const int numRules = static_cast<int>(p1.genome.size());
+    std::uniform_int_distribution<> dis_points(1, numRules - 1);
+    int numPoints = dis_points(rng);
+    std::vector<char> &isPoint = crossoverPoints();
+    isPoint.assign(numRules, 0);
+    for (int chosen = 0; chosen < numPoints;) {
+        int point = dis_points(rng);
+        if (!isPoint[point]) {
+            isPoint[point] = 1;
+            chosen++;
+        }
+    }
+
+    // Cada trecho entre dois pontos é copiado de uma vez, alternando os pais.
+    o1.genome.resize(numRules);
+    o2.genome.resize(numRules);
+    const uint32_t *a = p1.genome.data();
+    const uint32_t *b = p2.genome.data();
+    int last = 0;
+    for (int i = 1; i <= numRules; i++) {
+        if (i < numRules && !isPoint[i]) continue;
+        std::copy(a + last, a + i, o1.genome.data() + last);
+        std::copy(b + last, b + i, o2.genome.data() + last);
+        std::swap(a, b);
+        last = i;
+    }
+}
+
+void mutate(Individual &ind, double mutationRate, Xoshiro256 &rng) {
+    if (mutationRate <= 0.0) return;
+    const long long fields = static_cast<long long>(ind.genome.size()) * GENE_FIELDS;
+
+    // Cada campo muda com probabilidade mutationRate, independentemente dos outros; a distância
+    // até o próximo campo sorteado é geométrica, então só os campos que mudam custam sorteios.
+    const bool everyField = mutationRate >= 1.0;
+    std::geometric_distribution<long long> gap(everyField ? 0.5 : mutationRate);
+    auto skip = [&]() { return everyField ? 0 : gap(rng); };
+    for (long long f = skip(); f < fields; f += 1 + skip()) {
+        const int field = static_cast<int>(f % GENE_FIELDS);
+        uint32_t &gene = ind.genome[f / GENE_FIELDS];
+        gene = withGeneField(gene, field, std::uniform_int_distribution<>(FIELD_RANGE[field][0], FIELD_RANGE[field][1])(rng));
+    }
+}
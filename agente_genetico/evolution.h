@@ -0,0 +1,98 @@
+/**
+ * @file evolution.h
+ * @brief Operadores do Algoritmo Genético e a partida de avaliação de um indivíduo.
+ * @details Funções puras em relação à configuração do treinamento: tudo que elas usam
+ * (número de regras, taxa de mutação, tamanho do torneio) chega por parâmetro, para que
+ * possam ser usadas fora do laço de treinamento (ex: benchmarks/).
+ */
+
+#ifndef CAMPO_MINADO_EVOLUTION_H
+#define CAMPO_MINADO_EVOLUTION_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../comum/game.h"
+#include "../comum/rng.h"
+#include "fitness_cache.h"
+#include "rules.h"
+
+/**
+ * @brief Cria um novo indivíduo com um conjunto de regras totalmente aleatórias.
+ * @param numRules Número de regras do genoma.
+ * @return Um objeto Individual, já compilado.
+ */
+Individual createRandomIndividual(int numRules, Xoshiro256 &rng);
+
+/**
+ * @brief Pontuação de uma partida de avaliação a partir dos seus contadores finais.
+ * @details Calcula a pontuação com base em células seguras reveladas, bandeiras corretas,
+ * penalidades por erros e um grande bônus por vitória.
+ */
+ScenarioScore scoreScenario(int safeRevealed, int correctFlags, int minesRevealed, int actionsTaken, bool won);
+
+/**
+ * @brief Joga um único cenário de teste e devolve a pontuação obtida (ver scoreScenario).
+ * @param ind O indivíduo a ser avaliado.
+ * @param startBoard Tabuleiro inicial do cenário (já aberto a partir do ponto de partida).
+ * @param scenarioSeed Semente das jogadas aleatórias no cenário.
+ * @param game Tabuleiro de trabalho, sobrescrito com startBoard antes da partida.
+ * @return A pontuação do indivíduo no cenário e se ele venceu.
+ */
+ScenarioScore evaluateScenario(const Individual &ind, const Game &startBoard, uint64_t scenarioSeed, Game &game);
+
+/**
+ * @brief Joga um cenário como evaluateScenario, gravando as jogadas que mudam o tabuleiro.
+ * @details A pontuação é a mesma de evaluateScenario (e das avaliações em lote e na GPU), e
+ * as jogadas, aplicadas ao tabuleiro inicial, reproduzem a partida (ver replay_log.h).
+ * @param moves Saída com as jogadas, codificadas por encodeMove.
+ */
+ScenarioScore recordScenario(const Individual &ind, const Game &startBoard, uint64_t scenarioSeed, Game &game,
+                             std::vector<uint32_t> &moves);
+
+/**
+ * @brief Avalia o desempenho de um indivíduo em um conjunto de cenários de teste.
+ * @param startBoards Tabuleiro inicial de cada cenário.
+ * @param scenarioSeeds Semente das jogadas aleatórias de cada cenário (mesma ordem).
+ * @param game Tabuleiro de trabalho reaproveitado em todas as partidas.
+ * @param wins Somado com o número de vitórias.
+ * @return O valor médio de fitness do indivíduo nos cenários.
+ */
+double evaluateIndividual(const Individual &ind, const std::vector<Game> &startBoards, const std::vector<uint64_t> &scenarioSeeds,
+                          Game &game, int &wins);
+
+/**
+ * @brief Calcula a distância genética entre dois indivíduos (fração dos genes diferentes). Usado no niching.
+ * @details Compara os campos de cada regra, menos a prioridade, com um XOR e um popcount por palavra do genoma.
+ */
+double calculateGeneticDistance(const Individual &a, const Individual &b);
+
+/**
+ * @brief Seleciona um indivíduo da população para ser um "pai".
+ * @details Usa o método de seleção por torneio. Um número de indivíduos (tournamentSize)
+ * é escolhido aleatoriamente, e o de maior fitness vence, sendo selecionado para reprodução.
+ * Só os índices são comparados; nenhum indivíduo é copiado.
+ * @param pop A população atual.
+ * @param rng Gerador do fluxo de reprodução da geração.
+ * @return O índice, em pop, do indivíduo selecionado.
+ */
+int tournamentSelection(const std::vector<Individual> &pop, int tournamentSize, Xoshiro256 &rng);
+
+/**
+ * @brief Realiza o cruzamento (reprodução) entre dois pais para gerar dois filhos.
+ * @details Utiliza a técnica de crossover de múltiplos pontos, misturando os "genes" (regras)
+ * dos pais em vários locais aleatórios para criar os filhos: cada trecho entre dois pontos de
+ * corte é copiado inteiro do genoma de um dos pais. Os pais têm o mesmo número de regras.
+ */
+void crossover(const Individual &p1, const Individual &p2, Individual &o1, Individual &o2, Xoshiro256 &rng);
+
+/**
+ * @brief Aplica mutações aleatórias a um indivíduo.
+ * @details Cada "gene" (valor dentro de uma regra), com uma pequena probabilidade
+ * (mutationRate), é trocado por um novo valor aleatório do seu intervalo. É a fonte de
+ * inovação genética. Em vez de um sorteio por campo, sorteia-se a distância até o próximo
+ * campo que muda (distribuição geométrica), então o custo é proporcional às mutações.
+ */
+void mutate(Individual &ind, double mutationRate, Xoshiro256 &rng);
+
+#endif // CAMPO_MINADO_EVOLUTION_H
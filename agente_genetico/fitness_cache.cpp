@@ -0,0 +1,46 @@
+/**
+ * @file fitness_cache.cpp
+ * @brief Implementação da memória de pontuações por programa de regras.
+ */
+
+#include "fitness_cache.h"
+
+#include <unordered_set>
+
+const ScenarioScore *FitnessCache::find(const RuleProgram &program, size_t scenario) const {
+    auto it = entries.find(program.hash);
+    if (it == entries.end() || !sameProgram(it->second.program, program)) return nullptr;
+    for (const auto &entry : it->second.scores) {
+        if (entry.first == scenario) return &entry.second;
+    }
+    return nullptr;
+}
+
+void FitnessCache::store(const RuleProgram &program, size_t scenario, const ScenarioScore &score) {
+    if (maxScenarios == 0) return;
+    auto it = entries.find(program.hash);
+    if (it == entries.end()) {
+        it = entries.emplace(program.hash, Entry{program, {}}).first;
+    } else if (!sameProgram(it->second.program, program)) {
+        return;
+    }
+    auto &scores = it->second.scores;
+    for (auto &entry : scores) {
+        if (entry.first == scenario) {
+            entry.second = score;
+            return;
+        }
+    }
+    if (scores.size() >= maxScenarios) scores.erase(scores.begin());
+    scores.emplace_back(scenario, score);
+}
+
+void FitnessCache::retain(const std::vector<Individual> &population) {
+    std::unordered_set<uint64_t> alive;
+    alive.reserve(population.size());
+    for (const auto &ind : population) alive.insert(ind.program.hash);
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (alive.count(it->first)) ++it;
+        else it = entries.erase(it);
+    }
+}
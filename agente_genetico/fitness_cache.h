@@ -0,0 +1,73 @@
+/**
+ * @file fitness_cache.h
+ * @brief Memória das pontuações já calculadas de cada programa de regras, cenário a cenário.
+ * @details A pontuação de um indivíduo em um cenário depende só do seu RuleProgram e do
+ * cenário (as jogadas aleatórias usam uma semente derivada do índice do cenário no banco).
+ * Então os elites, os filhos copiados sem crossover nem mutação efetiva e os clones dentro
+ * da população não precisam jogar de novo um cenário que o mesmo programa já jogou. Como
+ * a memória é por cenário, quando a amostra da geração muda só em parte, apenas os
+ * cenários novos são jogados.
+ *
+ * O cache guarda apenas os programas da população atual (retain) e, para cada um, as
+ * pontuações dos últimos `maxScenariosPerProgram` cenários jogados. É usado somente pela
+ * thread principal, antes e depois do laço paralelo da avaliação.
+ */
+
+#ifndef CAMPO_MINADO_FITNESS_CACHE_H
+#define CAMPO_MINADO_FITNESS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rules.h"
+
+/**
+ * @struct ScenarioScore
+ * @brief Resultado de uma partida de avaliação.
+ */
+struct ScenarioScore {
+    double score = 0.0; // Pontuação da partida (ver evaluateScenario).
+    bool won = false;   // A partida terminou em vitória.
+};
+
+/**
+ * @class FitnessCache
+ * @brief Mapa programa -> (cenário -> pontuação), indexado por RuleProgram::hash.
+ */
+class FitnessCache {
+public:
+    explicit FitnessCache(size_t maxScenariosPerProgram = 256) : maxScenarios(maxScenariosPerProgram) {}
+
+    /**
+     * @brief Pontuação já calculada de `program` no cenário `scenario` do banco.
+     * @return nullptr se o par ainda não foi jogado.
+     */
+    const ScenarioScore *find(const RuleProgram &program, size_t scenario) const;
+
+    /**
+     * @brief Guarda a pontuação de `program` no cenário `scenario`.
+     * @details Se o programa já tiver `maxScenariosPerProgram` cenários, o mais antigo é
+     * esquecido. Em uma colisão de hash com outro programa, nada é guardado.
+     */
+    void store(const RuleProgram &program, size_t scenario, const ScenarioScore &score);
+
+    /** @brief Esquece os programas que não aparecem em `population`. */
+    void retain(const std::vector<Individual> &population);
+
+    /** @brief Número de programas guardados. */
+    size_t size() const { return entries.size(); }
+
+private:
+    struct Entry {
+        RuleProgram program;                                 // Para descartar colisões de hash.
+        std::vector<std::pair<size_t, ScenarioScore>> scores; // Em ordem de inserção.
+    };
+
+    std::unordered_map<uint64_t, Entry> entries;
+    size_t maxScenarios;
+};
+
+#endif // CAMPO_MINADO_FITNESS_CACHE_H
@@ -0,0 +1,242 @@
+/**
+ * @file gpu_eval.cpp
+ * @brief Backend OpenCL da avaliação: montagem das tabelas no host, buffers e lançamento do kernel.
+ */
+
+#include "gpu_eval.h"
+
+#include <cstring>
+#include <iostream>
+
+#ifdef CAMPO_MINADO_OPENCL
+
+#define CL_TARGET_OPENCL_VERSION 120
+#ifdef __APPLE__
+#include <OpenCL/opencl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include "gpu_kernel.h"
+
+namespace {
+
+/** @brief Imprime o erro do OpenCL, se houver; verdadeiro se `err` indica sucesso. */
+bool check(cl_int err, const char *what) {
+    if (err == CL_SUCCESS) return true;
+    std::cerr << "Erro OpenCL " << err << " em " << what << "." << std::endl;
+    return false;
+}
+
+/**
+ * @struct DeviceBuffer
+ * @brief Buffer do dispositivo que só é realocado quando precisa crescer.
+ */
+struct DeviceBuffer {
+    cl_mem mem = nullptr;
+    size_t capacity = 0;
+
+    ~DeviceBuffer() { release(); }
+
+    void release() {
+        if (mem) clReleaseMemObject(mem);
+        mem = nullptr;
+        capacity = 0;
+    }
+
+    /** @brief Garante espaço para `bytes` e copia `data` (se não for nulo) para o início. */
+    bool upload(cl_context context, cl_command_queue queue, cl_mem_flags flags, const void *data, size_t bytes) {
+        if (bytes == 0) bytes = 1; // Buffers de tamanho zero são inválidos no OpenCL.
+        if (bytes > capacity) {
+            release();
+            cl_int err;
+            mem = clCreateBuffer(context, flags, bytes + bytes / 2, nullptr, &err);
+            if (!check(err, "clCreateBuffer")) return false;
+            capacity = bytes + bytes / 2;
+        }
+        if (!data) return true;
+        return check(clEnqueueWriteBuffer(queue, mem, CL_FALSE, 0, bytes, data, 0, nullptr, nullptr), "clEnqueueWriteBuffer");
+    }
+};
+
+} // namespace
+
+struct GpuEvaluator::Device {
+    cl_context context = nullptr;
+    cl_command_queue queue = nullptr;
+    cl_program program = nullptr;
+    cl_kernel kernel = nullptr;
+    size_t workGroup = 64;
+
+    DeviceBuffer rules, buckets, scenarios, seeds, taskProgram, taskScenario, results;
+
+    ~Device() {
+        // Os buffers precisam ser liberados antes do contexto.
+        for (DeviceBuffer *buffer : {&rules, &buckets, &scenarios, &seeds, &taskProgram, &taskScenario, &results}) buffer->release();
+        if (kernel) clReleaseKernel(kernel);
+        if (program) clReleaseProgram(program);
+        if (queue) clReleaseCommandQueue(queue);
+        if (context) clReleaseContext(context);
+    }
+};
+
+bool GpuEvaluator::compiledIn() { return true; }
+
+bool GpuEvaluator::init(const BoardConfig &boardConfig, int deviceIndex) {
+    board = boardConfig;
+    if ((board.width + 4) * (board.height + 4) > 65535) {
+        std::cerr << "Tabuleiro grande demais para o backend de GPU." << std::endl;
+        return false;
+    }
+
+    // Todos os dispositivos de todas as plataformas, na ordem em que são listados.
+    cl_uint platformCount = 0;
+    if (!check(clGetPlatformIDs(0, nullptr, &platformCount), "clGetPlatformIDs") || platformCount == 0) {
+        std::cerr << "Nenhuma plataforma OpenCL encontrada." << std::endl;
+        return false;
+    }
+    std::vector<cl_platform_id> platforms(platformCount);
+    clGetPlatformIDs(platformCount, platforms.data(), nullptr);
+    std::vector<cl_device_id> devices;
+    for (cl_platform_id platform : platforms) {
+        cl_uint count = 0;
+        if (clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, 0, nullptr, &count) != CL_SUCCESS || count == 0) continue;
+        size_t first = devices.size();
+        devices.resize(first + count);
+        clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, count, devices.data() + first, nullptr);
+    }
+    if (deviceIndex < 0 || deviceIndex >= static_cast<int>(devices.size())) {
+        std::cerr << "Dispositivo OpenCL " << deviceIndex << " inexistente (" << devices.size() << " encontrados)." << std::endl;
+        return false;
+    }
+    cl_device_id id = devices[deviceIndex];
+    char deviceName[256] = {};
+    clGetDeviceInfo(id, CL_DEVICE_NAME, sizeof(deviceName) - 1, deviceName, nullptr);
+    name = deviceName;
+
+    std::unique_ptr<Device> d(new Device());
+    cl_int err;
+    d->context = clCreateContext(nullptr, 1, &id, nullptr, nullptr, &err);
+    if (!check(err, "clCreateContext")) return false;
+    d->queue = clCreateCommandQueue(d->context, id, 0, &err);
+    if (!check(err, "clCreateCommandQueue")) return false;
+
+    const char *source = GPU_KERNEL_SOURCE;
+    d->program = clCreateProgramWithSource(d->context, 1, &source, nullptr, &err);
+    if (!check(err, "clCreateProgramWithSource")) return false;
+    const std::string buildOptions = "-DWIDTH=" + std::to_string(board.width) + " -DHEIGHT=" + std::to_string(board.height) +
+                                     " -DMINES=" + std::to_string(board.numMines);
+    if (clBuildProgram(d->program, 1, &id, buildOptions.c_str(), nullptr, nullptr) != CL_SUCCESS) {
+        size_t logSize = 0;
+        clGetProgramBuildInfo(d->program, id, CL_PROGRAM_BUILD_LOG, 0, nullptr, &logSize);
+        std::string log(logSize, '\0');
+        clGetProgramBuildInfo(d->program, id, CL_PROGRAM_BUILD_LOG, logSize, &log[0], nullptr);
+        std::cerr << "Erro ao compilar o kernel OpenCL:" << std::endl << log << std::endl;
+        return false;
+    }
+    d->kernel = clCreateKernel(d->program, "playPairs", &err);
+    if (!check(err, "clCreateKernel")) return false;
+    size_t preferred = 0;
+    if (clGetKernelWorkGroupInfo(d->kernel, id, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE, sizeof(preferred), &preferred, nullptr) == CL_SUCCESS &&
+        preferred > 0) {
+        d->workGroup = preferred;
+    }
+    device = std::move(d);
+    return true;
+}
+
+bool GpuEvaluator::setScenarios(const std::vector<Scenario> &scenarios, const std::vector<uint64_t> &seeds) {
+    if (!device) return false;
+    // Mesmo registro do banco: startX e startY (16 bits) e um bit de mina por casa.
+    const size_t maskBytes = (static_cast<size_t>(board.width) * board.height + 7) / 8;
+    const size_t recordSize = 4 + maskBytes;
+    std::vector<uint8_t> records(scenarios.size() * recordSize);
+    for (size_t i = 0; i < scenarios.size(); i++) {
+        uint8_t *record = &records[i * recordSize];
+        record[0] = static_cast<uint8_t>(scenarios[i].startX);
+        record[1] = static_cast<uint8_t>(scenarios[i].startX >> 8);
+        record[2] = static_cast<uint8_t>(scenarios[i].startY);
+        record[3] = static_cast<uint8_t>(scenarios[i].startY >> 8);
+        std::memcpy(record + 4, scenarios[i].mineBits, maskBytes);
+    }
+    Device &d = *device;
+    return d.scenarios.upload(d.context, d.queue, CL_MEM_READ_ONLY, records.data(), records.size()) &&
+           d.seeds.upload(d.context, d.queue, CL_MEM_READ_ONLY, seeds.data(), seeds.size() * sizeof(uint64_t)) &&
+           check(clFinish(d.queue), "clFinish");
+}
+
+bool GpuEvaluator::play(const std::vector<const RuleProgram *> &programs, const std::vector<int> &taskProgram,
+                        const std::vector<int> &taskScenario, std::vector<LaneResult> &results) {
+    if (!device) return false;
+    Device &d = *device;
+    const cl_int taskCount = static_cast<cl_int>(taskProgram.size());
+    results.resize(taskProgram.size());
+    if (taskCount == 0) return true;
+
+    // Regras de todos os programas em sequência; os grupos viram índices absolutos.
+    ruleWords.clear();
+    bucketWords.clear();
+    for (const RuleProgram *program : programs) {
+        const uint32_t base = static_cast<uint32_t>(ruleWords.size());
+        for (uint16_t start : program->bucketStart) bucketWords.push_back(base + start);
+        for (const CompiledRule &rule : program->rules) {
+            ruleWords.push_back(rule.hiddenCondition | (rule.flaggedCondition << 8) | ((rule.scope == 2) << 16) |
+                                (rule.nearEdge << 17) | ((rule.action == ACTION_PLACE_FLAG) << 18));
+        }
+    }
+
+    if (!d.rules.upload(d.context, d.queue, CL_MEM_READ_ONLY, ruleWords.data(), ruleWords.size() * sizeof(uint32_t)) ||
+        !d.buckets.upload(d.context, d.queue, CL_MEM_READ_ONLY, bucketWords.data(), bucketWords.size() * sizeof(uint32_t)) ||
+        !d.taskProgram.upload(d.context, d.queue, CL_MEM_READ_ONLY, taskProgram.data(), taskProgram.size() * sizeof(int)) ||
+        !d.taskScenario.upload(d.context, d.queue, CL_MEM_READ_ONLY, taskScenario.data(), taskScenario.size() * sizeof(int)) ||
+        !d.results.upload(d.context, d.queue, CL_MEM_WRITE_ONLY, nullptr, taskProgram.size() * 5 * sizeof(int32_t))) {
+        return false;
+    }
+
+    cl_mem args[] = {d.rules.mem, d.buckets.mem, d.scenarios.mem, d.seeds.mem, d.taskProgram.mem, d.taskScenario.mem};
+    for (cl_uint i = 0; i < 6; i++) {
+        if (!check(clSetKernelArg(d.kernel, i, sizeof(cl_mem), &args[i]), "clSetKernelArg")) return false;
+    }
+    if (!check(clSetKernelArg(d.kernel, 6, sizeof(cl_int), &taskCount), "clSetKernelArg") ||
+        !check(clSetKernelArg(d.kernel, 7, sizeof(cl_mem), &d.results.mem), "clSetKernelArg")) {
+        return false;
+    }
+
+    const size_t global = (static_cast<size_t>(taskCount) + d.workGroup - 1) / d.workGroup * d.workGroup;
+    if (!check(clEnqueueNDRangeKernel(d.queue, d.kernel, 1, nullptr, &global, &d.workGroup, 0, nullptr, nullptr), "clEnqueueNDRangeKernel")) {
+        return false;
+    }
+    rawResults.resize(taskProgram.size() * 5);
+    if (!check(clEnqueueReadBuffer(d.queue, d.results.mem, CL_TRUE, 0, rawResults.size() * sizeof(int32_t), rawResults.data(), 0, nullptr, nullptr),
+               "clEnqueueReadBuffer")) {
+        return false;
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+        const int32_t *r = &rawResults[i * 5];
+        results[i] = {r[0], r[1], r[2], r[3], r[4] != 0};
+    }
+    return true;
+}
+
+#else // !CAMPO_MINADO_OPENCL
+
+struct GpuEvaluator::Device {};
+
+bool GpuEvaluator::compiledIn() { return false; }
+
+bool GpuEvaluator::init(const BoardConfig &, int) {
+    std::cerr << "Backend de GPU indisponivel: recompile com -DCAMPO_MINADO_OPENCL -lOpenCL." << std::endl;
+    return false;
+}
+
+bool GpuEvaluator::setScenarios(const std::vector<Scenario> &, const std::vector<uint64_t> &) { return false; }
+
+bool GpuEvaluator::play(const std::vector<const RuleProgram *> &, const std::vector<int> &, const std::vector<int> &,
+                        std::vector<LaneResult> &) {
+    return false;
+}
+
+#endif // CAMPO_MINADO_OPENCL
+
+GpuEvaluator::GpuEvaluator() = default;
+GpuEvaluator::~GpuEvaluator() = default;
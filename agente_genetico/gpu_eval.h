@@ -0,0 +1,80 @@
+/**
+ * @file gpu_eval.h
+ * @brief Backend opcional de avaliação em GPU (OpenCL) para o agente genético.
+ * @details Com `--gpu=true`, os pares (indivíduo, cenário) de cada geração são jogados na
+ * GPU, um por work-item, em vez de no pool de threads. O kernel (gpu_kernel.h) recebe os
+ * programas de regras compilados e os registros do banco de cenários, joga cada partida
+ * como evaluateScenario e devolve os contadores finais; a pontuação continua sendo
+ * calculada na CPU, então o resultado é idêntico ao da avaliação na CPU.
+ *
+ * O suporte é opcional em tempo de compilação: compile com `-DCAMPO_MINADO_OPENCL -lOpenCL`
+ * (e os headers do OpenCL instalados). Sem isso, init() só avisa que o backend não está disponível.
+ */
+
+#ifndef CAMPO_MINADO_GPU_EVAL_H
+#define CAMPO_MINADO_GPU_EVAL_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../comum/config.h"
+#include "lockstep_sim.h"
+#include "rules.h"
+#include "scenario_bank.h"
+
+/**
+ * @class GpuEvaluator
+ * @brief Contexto OpenCL, kernel compilado para o tabuleiro e buffers reaproveitados entre as gerações.
+ * @details Não é thread-safe; o laço de treinamento usa um único avaliador.
+ */
+class GpuEvaluator {
+public:
+    GpuEvaluator();
+    ~GpuEvaluator();
+    GpuEvaluator(const GpuEvaluator &) = delete;
+    GpuEvaluator &operator=(const GpuEvaluator &) = delete;
+
+    /** @brief Verdadeiro se o programa foi compilado com suporte a OpenCL. */
+    static bool compiledIn();
+
+    /**
+     * @brief Escolhe o dispositivo e compila o kernel para as dimensões do tabuleiro.
+     * @param device Índice do dispositivo entre todos os dispositivos OpenCL encontrados.
+     * @return false se não houver suporte ou o dispositivo não puder ser usado (a mensagem já foi impressa).
+     */
+    bool init(const BoardConfig &board, int device);
+
+    /** @brief Nome do dispositivo em uso (vazio antes de init()). */
+    const std::string &deviceName() const { return name; }
+
+    /**
+     * @brief Envia os cenários da geração para a GPU.
+     * @param scenarios Cenários do banco, na ordem dos índices usados por play().
+     * @param seeds Semente das jogadas aleatórias de cada cenário.
+     */
+    bool setScenarios(const std::vector<Scenario> &scenarios, const std::vector<uint64_t> &seeds);
+
+    /**
+     * @brief Joga os pares (programs[taskProgram[i]], cenário taskScenario[i]) até o fim.
+     * @param results Recebe os contadores finais de cada par (mesmo formato do simulador em lote).
+     * @return false em caso de erro do OpenCL (a mensagem já foi impressa).
+     */
+    bool play(const std::vector<const RuleProgram *> &programs, const std::vector<int> &taskProgram,
+              const std::vector<int> &taskScenario, std::vector<LaneResult> &results);
+
+private:
+    struct Device; // Objetos OpenCL, definidos só em gpu_eval.cpp.
+
+    std::unique_ptr<Device> device;
+    std::string name;
+    BoardConfig board;
+
+    // Buffers de montagem no host, reaproveitados.
+    std::vector<uint32_t> ruleWords;
+    std::vector<uint32_t> bucketWords;
+    std::vector<int32_t> rawResults;
+};
+
+#endif // CAMPO_MINADO_GPU_EVAL_H
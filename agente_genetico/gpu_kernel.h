@@ -0,0 +1,280 @@
+/**
+ * @file gpu_kernel.h
+ * @brief Código-fonte OpenCL C do kernel de avaliação em GPU (ver gpu_eval.h).
+ * @details O kernel é compilado em tempo de execução, para o tabuleiro do treinamento, com
+ * -DWIDTH=.. -DHEIGHT=.. -DMINES=..: as dimensões viram constantes e o tabuleiro de cada
+ * partida cabe em arrays privados de tamanho fixo. Cada work-item joga um par (programa,
+ * cenário) do começo ao fim, repetindo evaluateScenario passo a passo:
+ *
+ * - o tabuleiro usa a mesma codificação de Game::cells (número, mina, estado e a borda de
+ *   PADDING = 2 sentinelas reveladas), mas sem o resumo de vizinhança, que ocuparia 9 bytes
+ *   por casa: as contagens das regras são recalculadas varrendo a janela;
+ * - as casas de uma janela são visitadas em ordem de linha, a mesma ordem dos bits de
+ *   CellFeatures::hiddenMask, então as regras escolhem os mesmos alvos;
+ * - as jogadas aleatórias usam o mesmo Xoshiro256 e o mesmo sorteio de Xoshiro256::below.
+ *
+ * Regras (uma palavra de 32 bits cada): bits 0-7 vizinhos ocultos, 8-15 bandeiras, bit 16
+ * escopo 2, bit 17 perto da borda, bit 18 ação de marcar. Cada programa tem 10 entradas em
+ * `buckets`, com os índices absolutos (em `rules`) do início de cada grupo, como
+ * RuleProgram::bucketStart. Cada cenário é um registro do banco: startX e startY (16 bits,
+ * little-endian) seguidos de um bit de mina por casa.
+ */
+
+#ifndef CAMPO_MINADO_GPU_KERNEL_H
+#define CAMPO_MINADO_GPU_KERNEL_H
+
+static const char GPU_KERNEL_SOURCE[] = R"CLC(
+#define PADDING 2
+#define STRIDE (WIDTH + 2 * PADDING)
+#define ROWS (HEIGHT + 2 * PADDING)
+#define CELLS (WIDTH * HEIGHT)
+#define MASK_BYTES ((CELLS + 7) / 8)
+#define RECORD_SIZE (4 + MASK_BYTES)
+
+#define NUMBER_MASK 0x0F
+#define MINE_BIT 0x10
+#define STATE_SHIFT 5
+#define STATE_MASK 0x60
+#define BORDER_BIT 0x80
+#define HIDDEN 0
+#define REVEALED 1
+#define FLAGGED 2
+
+#define RULE_SCOPE2 (1u << 16)
+#define RULE_NEAR_EDGE (1u << 17)
+#define RULE_FLAG (1u << 18)
+
+typedef struct {
+    uchar cells[STRIDE * ROWS];
+    ushort stack[CELLS];
+    int hiddenCount;
+    int revealedSafe;
+    int minesRevealed;
+    int correctFlags;
+    int over;
+    int won;
+    ulong s[4];
+} Board;
+
+inline int cellIndex(int x, int y) { return (y + PADDING) * STRIDE + (x + PADDING); }
+
+inline int stateOf(const Board *b, int idx) { return (b->cells[idx] & STATE_MASK) >> STATE_SHIFT; }
+
+ulong splitMix64(ulong *state) {
+    ulong z = (*state += 0x9E3779B97F4A7C15UL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+    return z ^ (z >> 31);
+}
+
+inline ulong rotl64(ulong x, int k) { return (x << k) | (x >> (64 - k)); }
+
+ulong nextRandom(Board *b) {
+    const ulong result = rotl64(b->s[1] * 5, 7) * 9;
+    const ulong t = b->s[1] << 17;
+    b->s[2] ^= b->s[0];
+    b->s[3] ^= b->s[1];
+    b->s[1] ^= b->s[2];
+    b->s[0] ^= b->s[3];
+    b->s[2] ^= t;
+    b->s[3] = rotl64(b->s[3], 45);
+    return result;
+}
+
+/* Xoshiro256::below: a parte alta do produto de 128 bits vem de mul_hi. */
+ulong randomBelow(Board *b, ulong n) {
+    ulong x = nextRandom(b);
+    ulong low = x * n;
+    if (low < n) {
+        const ulong threshold = (0 - n) % n;
+        while (low < threshold) {
+            x = nextRandom(b);
+            low = x * n;
+        }
+    }
+    return mul_hi(x, n);
+}
+
+void setState(Board *b, int idx, int s) {
+    const int old = stateOf(b, idx);
+    const int mine = (b->cells[idx] & MINE_BIT) != 0;
+    if (old == HIDDEN) b->hiddenCount--;
+    else if (old == FLAGGED) b->correctFlags -= mine;
+    else if (mine) b->minesRevealed--;
+    else b->revealedSafe--;
+
+    if (s == HIDDEN) b->hiddenCount++;
+    else if (s == FLAGGED) b->correctFlags += mine;
+    else if (mine) b->minesRevealed++;
+    else b->revealedSafe++;
+
+    b->cells[idx] = (uchar)((b->cells[idx] & ~STATE_MASK) | (s << STATE_SHIFT));
+}
+
+/* Game::revealIndex: flood fill com pilha, vitória conferida pelos contadores. */
+void reveal(Board *b, int idx) {
+    if (stateOf(b, idx) != HIDDEN) return;
+    setState(b, idx, REVEALED);
+    if (b->cells[idx] & MINE_BIT) { b->over = 1; return; }
+
+    if ((b->cells[idx] & NUMBER_MASK) == 0) {
+        int top = 0;
+        b->stack[top++] = (ushort)idx;
+        while (top > 0) {
+            const int current = b->stack[--top];
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    const int n = current + dy * STRIDE + dx;
+                    if ((dx == 0 && dy == 0) || stateOf(b, n) != HIDDEN) continue;
+                    setState(b, n, REVEALED);
+                    if ((b->cells[n] & NUMBER_MASK) == 0) b->stack[top++] = (ushort)n;
+                }
+            }
+        }
+    }
+    if (b->revealedSafe == CELLS - MINES) b->won = 1;
+}
+
+void loadScenario(Board *b, __global const uchar *record, ulong seed) {
+    for (int i = 0; i < STRIDE * ROWS; i++) b->cells[i] = (uchar)(BORDER_BIT | (REVEALED << STATE_SHIFT));
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            const int bit = y * WIDTH + x;
+            const int mine = (record[4 + (bit >> 3)] >> (bit & 7)) & 1;
+            b->cells[cellIndex(x, y)] = (uchar)((HIDDEN << STATE_SHIFT) | (mine ? MINE_BIT : 0));
+        }
+    }
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            const int idx = cellIndex(x, y);
+            if (b->cells[idx] & MINE_BIT) continue;
+            int count = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) count += (b->cells[idx + dy * STRIDE + dx] & MINE_BIT) != 0;
+            }
+            b->cells[idx] |= (uchar)count;
+        }
+    }
+    b->hiddenCount = CELLS;
+    b->revealedSafe = 0;
+    b->minesRevealed = 0;
+    b->correctFlags = 0;
+    b->over = 0;
+    b->won = 0;
+    for (int k = 0; k < 4; k++) b->s[k] = splitMix64(&seed);
+
+    const int startX = record[0] | (record[1] << 8);
+    const int startY = record[2] | (record[3] << 8);
+    if (startX < WIDTH && startY < HEIGHT) reveal(b, cellIndex(startX, startY));
+}
+
+/* Uma passada de applyRules com o programa [buckets[0], buckets[9]). */
+int applyRules(Board *b, __global const uint *rules, __global const uint *buckets) {
+    int changed = 0;
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            const int idx = cellIndex(x, y);
+            if (stateOf(b, idx) != REVEALED) continue;
+            const int number = b->cells[idx] & NUMBER_MASK;
+            const int nearEdge = x <= 1 || x >= WIDTH - 2 || y <= 1 || y >= HEIGHT - 2;
+            const uint end = buckets[number + 1];
+
+            // Contagens de raio 1 e 2, recalculadas só depois de uma regra disparar aqui.
+            int counted = 0, hidden1 = 0, flagged1 = 0, hidden2 = 0, flagged2 = 0;
+            for (uint r = buckets[number]; r < end; r++) {
+                const uint rule = rules[r];
+                if ((rule & RULE_NEAR_EDGE) && !nearEdge) continue;
+                if (!counted) {
+                    hidden1 = flagged1 = hidden2 = flagged2 = 0;
+                    for (int dy = -2; dy <= 2; dy++) {
+                        for (int dx = -2; dx <= 2; dx++) {
+                            const int s = stateOf(b, idx + dy * STRIDE + dx);
+                            const int inner = dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1;
+                            if (dx == 0 && dy == 0) continue;
+                            hidden2 += s == HIDDEN;
+                            flagged2 += s == FLAGGED;
+                            hidden1 += inner && s == HIDDEN;
+                            flagged1 += inner && s == FLAGGED;
+                        }
+                    }
+                    counted = 1;
+                }
+                const int radius = (rule & RULE_SCOPE2) ? 2 : 1;
+                const int hidden = radius == 2 ? hidden2 : hidden1;
+                const int flagged = radius == 2 ? flagged2 : flagged1;
+                if (hidden != (int)(rule & 0xFF) || flagged != (int)((rule >> 8) & 0xFF)) continue;
+
+                // Alvos em ordem de linha; um alvo já revelado pelo flood fill é ignorado.
+                int done = 0;
+                for (int dy = -radius; dy <= radius && !done; dy++) {
+                    for (int dx = -radius; dx <= radius && !done; dx++) {
+                        const int target = idx + dy * STRIDE + dx;
+                        if ((dx == 0 && dy == 0) || stateOf(b, target) != HIDDEN) continue;
+                        if (rule & RULE_FLAG) {
+                            setState(b, target, FLAGGED);
+                            done = 1;
+                        } else {
+                            reveal(b, target);
+                            done = b->over || b->won;
+                        }
+                    }
+                }
+                changed = 1;
+                counted = 0;
+                if (b->over || b->won) return changed;
+            }
+        }
+    }
+    return changed;
+}
+
+void revealRandom(Board *b) {
+    if (b->hiddenCount <= 0) return;
+    int pick = (int)randomBelow(b, (ulong)b->hiddenCount);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            const int idx = cellIndex(x, y);
+            if (stateOf(b, idx) == HIDDEN && pick-- == 0) {
+                reveal(b, idx);
+                return;
+            }
+        }
+    }
+}
+
+/* Resultado de cada par: acertos seguros, bandeiras corretas, minas reveladas, ações e vitória. */
+__kernel void playPairs(__global const uint *rules, __global const uint *buckets,
+                        __global const uchar *scenarios, __global const ulong *seeds,
+                        __global const int *taskProgram, __global const int *taskScenario,
+                        const int taskCount, __global int *results) {
+    const int task = (int)get_global_id(0);
+    if (task >= taskCount) return;
+    const int scenario = taskScenario[task];
+    __global const uint *programBuckets = buckets + 10 * taskProgram[task];
+
+    Board board;
+    loadScenario(&board, scenarios + (size_t)scenario * RECORD_SIZE, seeds[scenario]);
+    const int empty = programBuckets[0] == programBuckets[9];
+
+    int actions = 0;
+    int changed = 1;
+    while (!board.over && !board.won && changed) {
+        changed = !empty && applyRules(&board, rules, programBuckets);
+        if (changed) actions++;
+        if (!changed && !board.over && !board.won) {
+            revealRandom(&board);
+            actions++;
+            changed = 1;
+        }
+    }
+
+    __global int *out = results + 5 * task;
+    out[0] = board.revealedSafe;
+    out[1] = board.correctFlags;
+    out[2] = board.minesRevealed;
+    out[3] = actions;
+    out[4] = board.won;
+}
+)CLC";
+
+#endif // CAMPO_MINADO_GPU_KERNEL_H
@@ -0,0 +1,80 @@
+/**
+ * @file island.cpp
+ * @brief Implementação da troca de migrantes entre ilhas.
+ */
+
+#include "island.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../comum/rng.h"
+#include "population_file.h"
+
+MigrationChannel::MigrationChannel(const IslandConfig &config, int numRules) : config(config), numRules(numRules) {
+    // Relógio e pid: diferente a cada execução, mesmo com a mesma semente. Nunca é 0.
+    const uint64_t now = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    session = deriveSeed(now, {static_cast<uint64_t>(::getpid()), static_cast<uint64_t>(config.id)}) | 1;
+}
+
+bool MigrationChannel::prepare() const {
+    if (::mkdir(config.directory.c_str(), 0755) == 0 || errno == EEXIST) return true;
+    std::cerr << "Erro ao criar o diretorio de migracao " << config.directory << "." << std::endl;
+    return false;
+}
+
+std::string MigrationChannel::migrantPath(int island) const {
+    return config.directory + "/ilha" + std::to_string(island) + ".mig";
+}
+
+bool MigrationChannel::publish(const std::vector<Individual> &population, const std::vector<int> &ranking, int generation) const {
+    std::vector<Individual> emigrants;
+    const size_t count = std::min(ranking.size(), static_cast<size_t>(config.migrants));
+    for (size_t i = 0; i < count; i++) emigrants.push_back(population[ranking[i]]);
+
+    // O pid no nome temporário evita colisões se dois processos usarem o mesmo id por engano.
+    const std::string path = migrantPath(config.id);
+    const std::string tmpPath = path + ".tmp." + std::to_string(::getpid());
+    std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<const char*>(&session), sizeof(session));
+    ofs.write(reinterpret_cast<const char*>(&generation), sizeof(generation));
+    bool ok = ofs && writePopulation(ofs, emigrants, generation);
+    ofs.close();
+    if (!ok || ofs.fail() || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Erro ao publicar os migrantes em " << path << "." << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MigrationChannel::receive(std::vector<Individual> &migrants) {
+    const int source = (config.id + config.count - 1) % config.count;
+    std::ifstream ifs(migrantPath(source), std::ios::binary);
+    if (!ifs) return false; // A ilha vizinha ainda não publicou nada.
+
+    uint64_t publisher;
+    int generation;
+    ifs.read(reinterpret_cast<char*>(&publisher), sizeof(publisher));
+    ifs.read(reinterpret_cast<char*>(&generation), sizeof(generation));
+    if (ifs.fail() || (publisher == lastSession && generation <= lastReceived)) return false;
+    if (!readPopulation(ifs, migrants, -1, numRules)) return false;
+    lastSession = publisher;
+    lastReceived = generation;
+    return !migrants.empty();
+}
+
+std::string MigrationChannel::checkpointPath(const std::string &populationFile) const {
+    const std::string suffix = ".ilha" + std::to_string(config.id);
+    const size_t slash = populationFile.find_last_of('/');
+    const size_t dot = populationFile.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return populationFile + suffix;
+    return populationFile.substr(0, dot) + suffix + populationFile.substr(dot);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file island.h
+ * @brief Modelo de ilhas: várias populações independentes que trocam migrantes por arquivos.
+ * @details Cada ilha é um processo do agente genético com o mesmo banco de cenários e os
+ * mesmos parâmetros, iniciado com `--islands=N --island=i` (0 <= i < N). As ilhas podem
+ * rodar na mesma máquina ou em nós diferentes que compartilhem o diretório de migração
+ * (ex: NFS). Cada ilha evolui sozinha com seus próprios fluxos aleatórios e seu próprio
+ * save (ver checkpointPath) e, a cada `interval` gerações:
+ *
+ * 1. publica seus `migrants` melhores indivíduos em `directory/ilha<i>.mig`. O arquivo é
+ *    escrito com outro nome e renomeado, então quem lê nunca vê um arquivo pela metade;
+ * 2. lê o arquivo da ilha anterior no anel (i - 1), se ele tiver sido publicado depois da
+ *    última leitura, e os migrantes substituem os últimos filhos da próxima geração.
+ *
+ * Cada processo publica com um identificador de sessão próprio, sorteado na inicialização
+ * a partir do relógio e do pid. Um arquivo é novo se vier de outra sessão ou, na mesma
+ * sessão, de uma geração posterior: assim uma ilha vizinha que reinicia (e volta a contar
+ * as gerações a partir do seu save, ou do zero) continua entregando migrantes.
+ *
+ * A troca nunca bloqueia: uma ilha mais lenta simplesmente entrega migrantes com menos
+ * frequência. O arquivo de migrantes tem a sessão (uint64) e a geração (int) seguidas de
+ * uma população no formato de population_file.h.
+ */
+
+#ifndef CAMPO_MINADO_ISLAND_H
+#define CAMPO_MINADO_ISLAND_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rules.h"
+
+/**
+ * @struct IslandConfig
+ * @brief Parâmetros do modelo de ilhas.
+ */
+struct IslandConfig {
+    int id = 0;                         // Índice desta ilha (--island).
+    int count = 1;                      // Número de ilhas (--islands); 1 desativa a migração.
+    int interval = 10;                  // Gerações entre migrações (--migration-interval).
+    int migrants = 5;                   // Indivíduos enviados por migração (--migrants).
+    std::string directory = "ilhas";    // Diretório compartilhado de migração (--migration-dir).
+
+    bool enabled() const { return count > 1; }
+};
+
+/**
+ * @class MigrationChannel
+ * @brief Envia e recebe migrantes pelo diretório compartilhado.
+ */
+class MigrationChannel {
+public:
+    MigrationChannel(const IslandConfig &config, int numRules);
+
+    /**
+     * @brief Cria o diretório de migração, se necessário.
+     * @return false se o diretório não existir e não puder ser criado.
+     */
+    bool prepare() const;
+
+    /**
+     * @brief Publica os melhores indivíduos desta ilha.
+     * @param population A população avaliada.
+     * @param ranking Índices dos melhores da população (ao menos os usados aqui), em ordem decrescente de fitness.
+     * @param generation A geração atual.
+     * @return false se o arquivo não puder ser escrito (a mensagem já foi impressa).
+     */
+    bool publish(const std::vector<Individual> &population, const std::vector<int> &ranking, int generation) const;
+
+    /**
+     * @brief Lê os migrantes mais recentes da ilha anterior no anel.
+     * @param migrants Saída com os indivíduos recebidos, já compilados.
+     * @return true se chegaram migrantes que ainda não tinham sido recebidos.
+     */
+    bool receive(std::vector<Individual> &migrants);
+
+    /**
+     * @brief Caminho do save desta ilha: `populationFile` com ".ilha<i>" antes da extensão.
+     */
+    std::string checkpointPath(const std::string &populationFile) const;
+
+private:
+    std::string migrantPath(int island) const;
+
+    IslandConfig config;
+    int numRules;
+    uint64_t session;          // Identificador das publicações deste processo.
+    uint64_t lastSession = 0;  // Sessão dos últimos migrantes recebidos (0: nenhum ainda).
+    int lastReceived = -1;     // Geração dos últimos migrantes recebidos.
+};
+
+#endif // CAMPO_MINADO_ISLAND_H
@@ -0,0 +1,311 @@
+/**
+ * @file lockstep_sim.cpp
+ * @brief Implementação do simulador em lote com comparações vetoriais entre as lanes.
+ */
+
+#include "lockstep_sim.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../comum/profiler.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr int LANES = LockstepSimulator::LANES;
+static_assert(LANES == 16, "As comparações vetoriais assumem 16 lanes de um byte.");
+
+/** @brief Máscara (bit b = lane b) das lanes com (v[b] & mask) == value. */
+inline uint32_t lanesMaskedEqual(const uint8_t *v, uint8_t mask, uint8_t value) {
+#if defined(__SSE2__)
+    __m128i x = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(v)), _mm_set1_epi8(static_cast<char>(mask)));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8(static_cast<char>(value)))));
+#else
+    uint32_t m = 0;
+    for (int b = 0; b < LANES; b++) m |= static_cast<uint32_t>((v[b] & mask) == value) << b;
+    return m;
+#endif
+}
+
+/**
+ * @brief Lanes em que as contagens do escopo de cada regra coincidem com as condições dela.
+ * @details `radius1` e `radius2` apontam para hidden1/flagged1 e hidden2/flagged2 de um
+ * CellBlock (16 + 16 bytes); `rule` para hidden/flagged seguidos de scope2/scope2Flagged
+ * de um TransposedRule. Cada lane escolhe as contagens do escopo da sua regra.
+ */
+inline uint32_t lanesMatching(const uint8_t *radius1, const uint8_t *radius2, const uint8_t *rule) {
+#if defined(__AVX2__)
+    const __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(radius1));
+    const __m256i r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(radius2));
+    const __m256i conditions = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rule));
+    const __m256i scope2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rule + 2 * LANES));
+    const __m256i counts = _mm256_blendv_epi8(r1, r2, scope2);
+    const uint32_t m = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(counts, conditions)));
+    return m & (m >> 16);
+#elif defined(__SSE2__)
+    uint32_t m[2];
+    for (int half = 0; half < 2; half++) {
+        const int o = half * LANES;
+        const __m128i scope2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rule + 2 * LANES + o));
+        const __m128i counts = _mm_or_si128(
+            _mm_andnot_si128(scope2, _mm_loadu_si128(reinterpret_cast<const __m128i *>(radius1 + o))),
+            _mm_and_si128(scope2, _mm_loadu_si128(reinterpret_cast<const __m128i *>(radius2 + o))));
+        const __m128i conditions = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rule + o));
+        m[half] = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(counts, conditions)));
+    }
+    return m[0] & m[1];
+#else
+    uint32_t m = 0;
+    for (int b = 0; b < LANES; b++) {
+        const uint8_t *counts = rule[2 * LANES + b] ? radius2 : radius1;
+        m |= static_cast<uint32_t>(counts[b] == rule[b] && counts[LANES + b] == rule[LANES + b]) << b;
+    }
+    return m;
+#endif
+}
+
+} // namespace
+
+LockstepSimulator::LockstepSimulator(int width, int height, int numMines)
+    : width(width), height(height), numMines(numMines) {
+    // A geometria (stride, deslocamentos e casas perto da borda) é a de um Game vazio.
+    Game shape(width, height, numMines);
+    stride = shape.stride;
+    for (int k = 0; k < 8; k++) neighborOffsets[k] = shape.neighborOffsets[k];
+    for (int k = 0; k < 24; k++) windowOffsets[k] = shape.windowOffsets[k];
+    blocks.resize(shape.cells.size());
+    nearEdge.resize(shape.cells.size());
+    for (size_t i = 0; i < shape.cells.size(); i++) nearEdge[i] = shape.features[i].nearEdge() ? 1 : 0;
+    floodStack.reserve(shape.cellCount());
+}
+
+void LockstepSimulator::load(const Game &start, uint64_t seed, const RuleProgram *const *programs, int count) {
+    laneCount = count;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        CellBlock &block = blocks[i];
+        const CellFeatures &f = start.features[i];
+        std::memset(block.code, start.cells[i], LANES);
+        std::memset(block.hidden1, f.hidden1, LANES);
+        std::memset(block.flagged1, f.flagged1, LANES);
+        std::memset(block.hidden2, f.hidden2, LANES);
+        std::memset(block.flagged2, f.flagged2, LANES);
+        std::fill(block.hiddenMask, block.hiddenMask + LANES, f.hiddenMask & CellFeatures::RADIUS2_MASK);
+        block.dirty = (1u << LANES) - 1;
+    }
+    for (int lane = 0; lane < count; lane++) {
+        LaneState &s = lanes[lane];
+        s.hiddenCount = start.hiddenCount;
+        s.revealedSafe = start.revealedSafe;
+        s.minesRevealed = start.minesRevealed;
+        s.flagsPlaced = start.flagsPlaced;
+        s.correctFlags = start.correctFlags;
+        s.actionsTaken = 0;
+        s.gameOver = start.gameOver;
+        s.youWin = start.youWin;
+        s.program = programs[lane];
+        s.rng.seed(seed);
+    }
+
+    // Transpõe os grupos: a posição r do grupo n guarda a r-ésima regra de cada lane.
+    rules.clear();
+    for (int n = 0; n < 9; n++) {
+        bucketStart[n] = static_cast<int>(rules.size());
+        int longest = 0;
+        for (int lane = 0; lane < count; lane++) {
+            longest = std::max(longest, programs[lane]->bucketStart[n + 1] - programs[lane]->bucketStart[n]);
+        }
+        for (int r = 0; r < longest; r++) {
+            TransposedRule t;
+            std::memset(t.hidden, 0xFF, LANES); // Nunca coincide com uma contagem (no máximo 24).
+            std::memset(t.flagged, 0xFF, LANES);
+            std::memset(t.scope2, 0, LANES);
+            std::memset(t.scope2Flagged, 0, LANES);
+            for (int lane = 0; lane < count; lane++) {
+                const RuleProgram &program = *programs[lane];
+                const int index = program.bucketStart[n] + r;
+                if (index >= program.bucketStart[n + 1]) continue;
+                const CompiledRule &rule = program.rules[index];
+                const uint32_t bit = 1u << lane;
+                t.hidden[lane] = rule.hiddenCondition;
+                t.flagged[lane] = rule.flaggedCondition;
+                t.scope2[lane] = t.scope2Flagged[lane] = rule.scope == 2 ? 0xFF : 0;
+                t.lanes |= bit;
+                if (rule.nearEdge) t.nearEdge |= bit;
+                if (rule.action == ACTION_PLACE_FLAG) t.flag |= bit;
+            }
+            rules.push_back(t);
+        }
+    }
+    bucketStart[9] = static_cast<int>(rules.size());
+}
+
+void LockstepSimulator::setState(int lane, int idx, CellState s) {
+    LaneState &ls = lanes[lane];
+    uint8_t &code = blocks[idx].code[lane];
+    const CellState old = static_cast<CellState>((code & Game::STATE_MASK) >> Game::STATE_SHIFT);
+    const bool mine = (code & Game::MINE_BIT) != 0;
+    if (old == HIDDEN) ls.hiddenCount--;
+    else if (old == FLAGGED) { ls.flagsPlaced--; ls.correctFlags -= mine; }
+    else if (old == REVEALED) { if (mine) ls.minesRevealed--; else ls.revealedSafe--; }
+
+    if (s == HIDDEN) ls.hiddenCount++;
+    else if (s == FLAGGED) { ls.flagsPlaced++; ls.correctFlags += mine; }
+    else if (s == REVEALED) { if (mine) ls.minesRevealed++; else ls.revealedSafe++; }
+
+    code = static_cast<uint8_t>((code & ~Game::STATE_MASK) | (s << Game::STATE_SHIFT));
+
+    // Mesma atualização incremental de Game::setState, na lane da partida. A própria casa e
+    // as 24 da janela precisam ser testadas de novo.
+    const uint32_t laneBit = 1u << lane;
+    blocks[idx].dirty |= laneBit;
+    const int dHidden = (s == HIDDEN) - (old == HIDDEN);
+    const int dFlagged = (s == FLAGGED) - (old == FLAGGED);
+    for (int k = 0; k < 24; ++k) {
+        CellBlock &block = blocks[idx + windowOffsets[k]];
+        const uint32_t bit = 1u << (23 - k);
+        block.dirty |= laneBit;
+        if (dHidden > 0) block.hiddenMask[lane] |= bit;
+        else if (dHidden < 0) block.hiddenMask[lane] &= ~bit;
+        block.hidden2[lane] = static_cast<uint8_t>(block.hidden2[lane] + dHidden);
+        block.flagged2[lane] = static_cast<uint8_t>(block.flagged2[lane] + dFlagged);
+        if (CellFeatures::RADIUS1_MASK & bit) {
+            block.hidden1[lane] = static_cast<uint8_t>(block.hidden1[lane] + dHidden);
+            block.flagged1[lane] = static_cast<uint8_t>(block.flagged1[lane] + dFlagged);
+        }
+    }
+}
+
+void LockstepSimulator::reveal(int lane, int idx) {
+    if (state(lane, idx) != HIDDEN) return;
+    setState(lane, idx, REVEALED);
+    LaneState &ls = lanes[lane];
+    if (blocks[idx].code[lane] & Game::MINE_BIT) { ls.gameOver = true; return; }
+
+    if ((blocks[idx].code[lane] & Game::NUMBER_MASK) == 0) {
+        uint64_t flooded = 0;
+        floodStack.push_back(idx);
+        while (!floodStack.empty()) {
+            const int current = floodStack.back();
+            floodStack.pop_back();
+            for (int offset : neighborOffsets) {
+                const int n = current + offset;
+                if (state(lane, n) != HIDDEN) continue;
+                setState(lane, n, REVEALED);
+                flooded++;
+                if ((blocks[n].code[lane] & Game::NUMBER_MASK) == 0) floodStack.push_back(n);
+            }
+        }
+        PROFILE_COUNT(FLOOD_CELLS, flooded);
+    }
+    if (ls.revealedSafe == width * height - numMines) ls.youWin = true;
+}
+
+void LockstepSimulator::placeFlag(int lane, int idx) {
+    if (state(lane, idx) != HIDDEN) return;
+    setState(lane, idx, FLAGGED);
+}
+
+void LockstepSimulator::revealRandom(int lane) {
+    // Mesmo sorteio de revealRandomCell, para que os fluxos aleatórios coincidam.
+    LaneState &ls = lanes[lane];
+    if (ls.hiddenCount <= 0) return;
+    PROFILE_COUNT(RANDOM_MOVES, 1);
+    int pick = static_cast<int>(ls.rng.below(ls.hiddenCount));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const int idx = (y + Game::PADDING) * stride + (x + Game::PADDING);
+            if (state(lane, idx) == HIDDEN && pick-- == 0) {
+                reveal(lane, idx);
+                return;
+            }
+        }
+    }
+}
+
+void LockstepSimulator::play(LaneResult *results) {
+    const uint8_t revealedCode = static_cast<uint8_t>(REVEALED << Game::STATE_SHIFT);
+    auto finished = [this](int lane) { return lanes[lane].gameOver || lanes[lane].youWin; };
+
+    uint64_t tests = 0; // Contadores de profiling, por lane, como em applyRules.
+    uint64_t firings = 0;
+    uint32_t active = 0;
+    uint32_t withRules = 0;
+    for (int b = 0; b < laneCount; b++) {
+        if (!finished(b)) active |= 1u << b;
+        if (!lanes[b].program->empty()) withRules |= 1u << b;
+    }
+
+    while (active != 0) {
+        // 1. Uma passada de applyRules em todas as lanes ativas.
+        uint32_t changed = 0;
+        uint32_t running = active & withRules;
+        for (int y = 0; y < height && running != 0; y++) {
+            for (int x = 0; x < width; x++) {
+                const int idx = (y + Game::PADDING) * stride + (x + Game::PADDING);
+                CellBlock &block = blocks[idx];
+                if ((block.dirty & running) == 0) continue;
+                uint32_t revealed = lanesMaskedEqual(block.code, Game::STATE_MASK | Game::MINE_BIT, revealedCode) & running & block.dirty;
+                if (revealed == 0) continue;
+                block.dirty &= ~revealed; // Uma regra que disparar aqui suja a casa de novo.
+
+                // O número da casa é o mesmo em todas as lanes (mesmo cenário).
+                const int number = block.code[__builtin_ctz(revealed)] & Game::NUMBER_MASK;
+                const uint32_t edgeAllowed = nearEdge[idx] ? ~0u : 0u;
+                for (int r = bucketStart[number]; r < bucketStart[number + 1] && revealed != 0; r++) {
+                    // As contagens são relidas a cada regra: uma regra que disparou já as atualizou.
+                    const TransposedRule &rule = rules[r];
+                    const uint32_t tested = revealed & rule.lanes & (edgeAllowed | ~rule.nearEdge);
+                    uint32_t fire = lanesMatching(block.hidden1, block.hidden2, rule.hidden) & tested;
+                    tests += __builtin_popcount(tested);
+                    firings += __builtin_popcount(fire);
+                    while (fire != 0) {
+                        const int lane = __builtin_ctz(fire);
+                        const uint32_t bit = 1u << lane;
+                        fire &= fire - 1;
+                        uint32_t targets = block.hiddenMask[lane] & (rule.scope2[lane] ? CellFeatures::RADIUS2_MASK : CellFeatures::RADIUS1_MASK);
+                        if (rule.flag & bit) {
+                            placeFlag(lane, idx + windowOffsets[__builtin_ctz(targets)]);
+                        } else {
+                            while (targets != 0 && !finished(lane)) {
+                                const int k = __builtin_ctz(targets);
+                                targets &= targets - 1;
+                                reveal(lane, idx + windowOffsets[k]);
+                            }
+                        }
+                        changed |= bit;
+                        if (finished(lane)) {
+                            running &= ~bit;
+                            revealed &= ~bit;
+                        }
+                    }
+                }
+            }
+        }
+
+        // 2. Como em evaluateScenario: cada passada com jogada conta uma ação; uma passada
+        // sem jogada vira um chute aleatório.
+        for (uint32_t m = active; m != 0; m &= m - 1) {
+            const int lane = __builtin_ctz(m);
+            if (!(changed & (1u << lane))) revealRandom(lane);
+            lanes[lane].actionsTaken++;
+            if (finished(lane)) active &= ~(1u << lane);
+        }
+    }
+
+    PROFILE_COUNT(RULE_TESTS, tests);
+    PROFILE_COUNT(RULE_FIRINGS, firings);
+    for (int b = 0; b < laneCount; b++) {
+        const LaneState &ls = lanes[b];
+        results[b].revealedSafe = ls.revealedSafe;
+        results[b].correctFlags = ls.correctFlags;
+        results[b].minesRevealed = ls.minesRevealed;
+        results[b].actionsTaken = ls.actionsTaken;
+        results[b].won = ls.youWin;
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file lockstep_sim.h
+ * @brief Simulador em lote: um cenário jogado por até 16 indivíduos em passo único (lockstep).
+ * @details As partidas das LANES lanes são intercaladas casa a casa (struct-of-arrays por
+ * casa): o byte de estado e as contagens de vizinhança de uma mesma casa nas 16 partidas
+ * ficam lado a lado, em um único CellBlock. Como todas as lanes jogam o mesmo cenário, o
+ * número de cada casa é o mesmo em todas elas; as regras também são transpostas, de modo
+ * que a r-ésima regra do grupo de cada número fica, lane a lane, em um TransposedRule.
+ *
+ * Cada passada percorre o tabuleiro uma vez para todas as lanes ativas. Em cada casa, a
+ * r-ésima regra de todos os programas é comparada com as contagens das 16 lanes de uma vez
+ * (SSE2, ou AVX2 com -mavx2/-march=native), e só as lanes em que ela dispara executam a
+ * ação, uma a uma. Lanes cuja partida terminou saem da máscara de lanes ativas.
+ *
+ * Cada casa guarda também uma máscara das lanes em que ela precisa ser reavaliada: uma casa
+ * cuja janela 5x5 não mudou desde a última vez que suas regras foram testadas não pode
+ * disparar nenhuma regra agora, então as passadas seguintes só testam as casas "sujas".
+ *
+ * Cada lane só altera o próprio tabuleiro, então a ordem de casas e de regras vista por
+ * uma lane é a mesma de applyRules: o resultado de cada partida é idêntico ao de
+ * evaluateScenario jogando o mesmo par (indivíduo, cenário) sozinho.
+ */
+
+#ifndef CAMPO_MINADO_LOCKSTEP_SIM_H
+#define CAMPO_MINADO_LOCKSTEP_SIM_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../comum/game.h"
+#include "../comum/rng.h"
+#include "rules.h"
+
+/**
+ * @struct LaneResult
+ * @brief Contadores finais de uma partida jogada em uma lane.
+ */
+struct LaneResult {
+    int revealedSafe = 0;
+    int correctFlags = 0;
+    int minesRevealed = 0;
+    int actionsTaken = 0;  // Passadas com alguma regra disparada mais chutes aleatórios.
+    bool won = false;
+};
+
+/**
+ * @class LockstepSimulator
+ * @brief Até LANES partidas de um mesmo cenário intercaladas, cada uma com o seu RuleProgram.
+ * @details Os buffers são alocados na construção e reaproveitados; use um por worker.
+ */
+class LockstepSimulator {
+public:
+    static constexpr int LANES = 16;
+
+    LockstepSimulator(int width, int height, int numMines);
+
+    /**
+     * @brief Prepara uma partida do cenário por lane, cada uma com o seu programa de regras.
+     * @param start Tabuleiro inicial do cenário (mesmas dimensões do simulador).
+     * @param seed Semente das jogadas aleatórias no cenário (a mesma de evaluateScenario).
+     * @param programs Programa de cada lane; precisam continuar válidos até o fim de play().
+     * @param count Número de lanes usadas (1 a LANES).
+     */
+    void load(const Game &start, uint64_t seed, const RuleProgram *const *programs, int count);
+
+    /**
+     * @brief Joga as partidas preparadas por load() até o fim.
+     * @param results Recebe uma entrada por lane usada.
+     */
+    void play(LaneResult *results);
+
+private:
+    /**
+     * @struct CellBlock
+     * @brief Uma casa do tabuleiro nas LANES partidas (mesma codificação de Game::cells e CellFeatures).
+     * @details hidden1/flagged1 e hidden2/flagged2 ficam adjacentes para serem comparados
+     * juntos em um registrador de 256 bits.
+     */
+    struct alignas(16) CellBlock {
+        uint8_t code[LANES];
+        uint8_t hidden1[LANES];
+        uint8_t flagged1[LANES];
+        uint8_t hidden2[LANES];
+        uint8_t flagged2[LANES];
+        uint32_t hiddenMask[LANES]; // Só os bits 0-23; a borda fica em `nearEdge`.
+        uint32_t dirty;             // Lanes em que a janela mudou desde o último teste das regras.
+    };
+
+    /**
+     * @struct TransposedRule
+     * @brief A r-ésima regra do grupo de um número em cada lane (condições de CompiledRule).
+     * @details hidden/flagged e scope2/scope2Flagged ficam adjacentes pelo mesmo motivo das
+     * contagens em CellBlock. Lanes cujo grupo tem menos de r + 1 regras ficam fora de `lanes`.
+     */
+    struct alignas(16) TransposedRule {
+        uint8_t hidden[LANES];
+        uint8_t flagged[LANES];
+        uint8_t scope2[LANES];        // 0xFF se a regra da lane usa o escopo 2 (5x5).
+        uint8_t scope2Flagged[LANES]; // Cópia de scope2, para selecionar as duas contagens juntas.
+        uint32_t lanes = 0;           // Lanes que têm esta regra.
+        uint32_t nearEdge = 0;        // Lanes em que a regra exige a casa perto da borda.
+        uint32_t flag = 0;            // Lanes em que a ação é marcar (as demais revelam).
+    };
+
+    /** @brief Contadores de uma lane, como os do Game. */
+    struct LaneState {
+        int hiddenCount = 0;
+        int revealedSafe = 0;
+        int minesRevealed = 0;
+        int flagsPlaced = 0;
+        int correctFlags = 0;
+        int actionsTaken = 0;
+        bool gameOver = false;
+        bool youWin = false;
+        const RuleProgram *program = nullptr;
+        Xoshiro256 rng;
+    };
+
+    void setState(int lane, int idx, CellState s);
+    void reveal(int lane, int idx);
+    void placeFlag(int lane, int idx);
+    void revealRandom(int lane);
+    CellState state(int lane, int idx) const {
+        return static_cast<CellState>((blocks[idx].code[lane] & Game::STATE_MASK) >> Game::STATE_SHIFT);
+    }
+
+    int width;
+    int height;
+    int numMines;
+    int stride;
+    int neighborOffsets[8];
+    int windowOffsets[24];
+    std::vector<CellBlock> blocks;   // Um por índice de Game::index (inclui a borda).
+    std::vector<uint8_t> nearEdge;   // A casa está a até 1 casa da borda (igual em todas as lanes).
+    LaneState lanes[LANES];
+    int laneCount = 0;
+    std::vector<TransposedRule> rules; // Regras transpostas, agrupadas pelo número da casa.
+    int bucketStart[10] = {};          // Grupo do número n: [bucketStart[n], bucketStart[n + 1]).
+    std::vector<int> floodStack;
+};
+
+#endif // CAMPO_MINADO_LOCKSTEP_SIM_H
@@ -7,8 +7,6 @@
  * A visualização (opcional) usa a biblioteca SDL2.
  */
 
-#include <SDL2/SDL.h>
-#include <SDL2/SDL_ttf.h>
 #include <iostream>
 #include <vector>
 #include <ctime>
@@ -17,998 +15,840 @@
 #include <string>
 #include <random>
 #include <fstream>
+#include <functional>
 #include <thread>
-#include <future>
 #include <cmath>
 #include <atomic>
 #include <mutex>
-
-// === Constantes do Jogo ===
-// Define as propriedades do tabuleiro do Campo Minado.
-const int CELL_SIZE = 20;
-const int GRID_WIDTH = 10;
-const int GRID_HEIGHT = 10;
-const int NUM_MINES = 15;
-
-// === Parâmetros do Algoritmo Genético ===
-// Estes parâmetros controlam o processo de evolução.
-// Parâmetros estruturais: NÃO ALTERE durante um treinamento para evitar corromper o save.
-const int POPULATION_SIZE = 300;     // Número de indivíduos em cada geração.
-const int NUM_RULES = 150;          // Número de regras no "cérebro" de cada indivíduo.
-
-// Parâmetros de processo: Podem ser ajustados entre sessões de treinamento.
-const double MUTATION_RATE = 0.02;    // Probabilidade de um gene sofrer uma mutação aleatória.
-const double CROSSOVER_RATE = 0.8;   // Probabilidade de dois pais cruzarem seus genes.
-const int TOURNAMENT_SIZE = 10;        // Número de indivíduos que competem na seleção de pais.
-
-// === Parâmetros de Avaliação ===
-const int FIXED_GAME_COUNT = 200;     // Número total de cenários de jogo a serem gerados no banco de testes.
-const int GAMES_PER_GENERATION = 20;  // Número de cenários aleatórios do banco usados para avaliar cada geração.
-
-// === Parâmetros de Desempenho e Visualização ===
-const int NUM_THREADS = 8;            // Número de threads para processar a avaliação de fitness em paralelo.
-const int NUM_INDIVIDUALS_TO_DISPLAY = 9; // Quantidade de melhores indivíduos a serem visualizados (0 para desativar).
-
-// Gerador de números aleatórios global.
-std::random_device rd_global;
-std::mt19937 gen_global(rd_global());
-
-// === Estruturas e Enums Fundamentais ===
-
-/**
- * @enum CellState
- * @brief Define os possíveis estados de uma célula no tabuleiro.
- */
-enum CellState { HIDDEN, REVEALED, FLAGGED };
+#include <csignal>
+#include <chrono>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../comum/board_shape.h"
+#include "../comum/config.h"
+#include "../comum/game.h"
+#include "../comum/profiler.h"
+#include "../comum/replay_log.h"
+#include "../comum/rng.h"
+#include "../comum/thread_pool.h"
+#include "checkpoint.h"
+#include "evolution.h"
+#include "fitness_cache.h"
+#include "gpu_eval.h"
+#include "island.h"
+#include "lockstep_sim.h"
+#include "population_file.h"
+#include "rules.h"
+#include "scenario_bank.h"
+#include "visualizer.h"
 
 /**
- * @struct Cell
- * @brief Representa uma única célula do tabuleiro.
+ * @struct TrainingConfig
+ * @brief Parâmetros do tabuleiro, do Algoritmo Genético, da avaliação e da visualização.
+ * @details Os valores abaixo são os padrões; todos podem ser alterados pela linha de comando
+ * ou por um arquivo de configuração (ver readTrainingConfig()), sem recompilar.
  */
-struct Cell {
-    bool isMine = false;
-    int neighboringMines = 0;
-    CellState state = HIDDEN;
+struct TrainingConfig {
+    // === Tabuleiro ===
+    BoardConfig board;               // Dimensões e minas do Campo Minado (padrão 10x10 com 15 minas).
+
+    // === Parâmetros do Algoritmo Genético ===
+    // Parâmetros estruturais: NÃO ALTERE durante um treinamento para evitar corromper o save.
+    int populationSize = 300;        // Número de indivíduos em cada geração.
+    int numRules = 150;              // Número de regras no "cérebro" de cada indivíduo.
+
+    // Parâmetros de processo: Podem ser ajustados entre sessões de treinamento.
+    double mutationRate = 0.02;      // Probabilidade de um gene sofrer uma mutação aleatória.
+    double crossoverRate = 0.8;      // Probabilidade de dois pais cruzarem seus genes.
+    int tournamentSize = 10;         // Número de indivíduos que competem na seleção de pais.
+
+    // === Parâmetros de Avaliação ===
+    int fixedGameCount = 200;        // Número total de cenários de jogo a serem gerados no banco de testes.
+    int gamesPerGeneration = 20;     // Número de cenários aleatórios do banco usados para avaliar cada geração.
+    bool fitnessCache = true;        // Reaproveita pontuações de programas e cenários já jogados (fitness_cache.h).
+    bool racing = false;             // Avaliação por corrida: para de jogar indivíduos claramente dominados.
+    int racingRound = 5;             // Cenários jogados por rodada da corrida.
+    double racingZ = 2.0;            // Erros-padrão usados no limite superior da diferença para o limiar da corrida.
+    bool lockstep = true;            // Joga cada cenário com até 16 indivíduos juntos (lockstep_sim.h); o resultado é o mesmo.
+    bool gpu = false;                // Joga os pares na GPU (gpu_eval.h) em vez de no pool de threads; o resultado é o mesmo.
+    int gpuDevice = 0;               // Índice do dispositivo OpenCL usado com --gpu.
+    uint64_t seed = 0;               // Semente mestra de todos os fluxos aleatórios (--seed; sorteada se omitida).
+
+    // === Modelo de Ilhas ===
+    IslandConfig islands;            // Ilhas e migração entre processos (ver island.h).
+
+    // === Parâmetros de Desempenho e Visualização ===
+    int numThreads = 0;              // Número de threads da avaliação de fitness (0 = todos os núcleos).
+    int individualsToDisplay = 9;    // Quantidade de melhores indivíduos a serem visualizados (0 para desativar).
+
+    // === Arquivos ===
+    std::string populationFile = "populacao_regras.dat"; // Save da população.
+    int checkpointInterval = 5;      // Gerações entre checkpoints da população.
+    int checkpointHistory = 2;       // Saves anteriores mantidos (populationFile.1, .2, ...).
+    std::string fixedGamesFile = "fixed_games.dat";      // Banco de cenários de teste.
+    std::string replayFile;          // Registro das partidas do melhor indivíduo (replay_log.h); vazio = desligado.
+    int replayInterval = 1;          // Gerações entre duas gravações no registro de partidas.
+
+    // === Profiling (exige compilar com -DCAMPO_MINADO_PROFILE; ver comum/profiler.h) ===
+    std::string profileFile;         // Registro por geração (.csv ou JSON lines); vazio = desligado.
+    std::string traceFile;           // Trace do Chrome; vazio = desligado.
+    int traceGenerations = 20;       // Gerações gravadas no trace (ele é escrito ao fim da última).
 };
 
-/**
- * @struct Game
- * @brief Gerencia o estado de uma única partida de Campo Minado.
- */
-struct Game {
-    std::vector<std::vector<Cell>> grid;
-    bool gameOver = false;
-    bool youWin = false;
-
-    Game() : grid(GRID_HEIGHT, std::vector<Cell>(GRID_WIDTH)) {}
-
-    /**
-     * @brief Inicializa o tabuleiro com um layout de minas pré-definido.
-     * @param startX Coordenada X do ponto de partida seguro.
-     * @param startY Coordenada Y do ponto de partida seguro.
-     * @param mineGrid Matriz booleana que define a localização de todas as minas.
-     */
-    void initializeGridFixed(int startX, int startY, const std::vector<std::vector<bool>> &mineGrid) {
-        gameOver = false;
-        youWin = false;
-
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            for (int x = 0; x < GRID_WIDTH; ++x) {
-                grid[y][x] = Cell();
-                grid[y][x].isMine = mineGrid[y][x];
-            }
-        }
-
-        // Calcula os números para cada célula com base nas minas vizinhas.
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            for (int x = 0; x < GRID_WIDTH; ++x) {
-                if (grid[y][x].isMine) continue;
-                grid[y][x].neighboringMines = 0;
-                for (int dy = -1; dy <= 1; ++dy) {
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        if (nx >= 0 && nx < GRID_WIDTH && ny >= 0 && ny < GRID_HEIGHT && grid[ny][nx].isMine) {
-                            grid[y][x].neighboringMines++;
-                        }
-                    }
-                }
-            }
-        }
-        // Revela a célula inicial segura.
-        if (startX >= 0 && startY >= 0) {
-            revealCell(startX, startY);
-        }
-    }
-
-    /**
-     * @brief Revela uma célula e, se for vazia, suas vizinhas recursivamente.
-     */
-    void revealCell(int x, int y) {
-        if (x < 0 || x >= GRID_WIDTH || y < 0 || y >= GRID_HEIGHT || grid[y][x].state != HIDDEN) return;
-        grid[y][x].state = REVEALED;
-        if (grid[y][x].isMine) { gameOver = true; return; }
-        if (grid[y][x].neighboringMines == 0) {
-            for (int dy = -1; dy <= 1; dy++) for (int dx = -1; dx <= 1; dx++) revealCell(x + dx, y + dy);
-        }
-        checkWinCondition();
-    }
-
-    /**
-     * @brief Coloca uma bandeira em uma célula oculta.
-     */
-    void placeFlag(int x, int y) {
-        if (x < 0 || x >= GRID_WIDTH || y < 0 || y >= GRID_HEIGHT || grid[y][x].state != HIDDEN) return;
-        grid[y][x].state = FLAGGED;
-    }
-
-    /**
-     * @brief Verifica se a condição de vitória foi atingida.
-     */
-    void checkWinCondition() {
-        int revealedCount = 0;
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            for (int x = 0; x < GRID_WIDTH; ++x) {
-                if (grid[y][x].state == REVEALED) {
-                    revealedCount++;
-                }
-            }
-        }
-        if (revealedCount == (GRID_WIDTH * GRID_HEIGHT) - NUM_MINES) {
-            youWin = true;
-        }
-    }
+// Configuração ativa do treinamento, preenchida no início de main().
+TrainingConfig config;
 
-    /**
-     * @brief Renderiza o estado atual do tabuleiro na tela (usado pela visualização).
-     */
-    void renderGrid(SDL_Renderer* renderer, TTF_Font* font, int offsetX, int offsetY) const {
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            for (int x = 0; x < GRID_WIDTH; ++x) {
-                SDL_Rect cellRect = {offsetX + x * CELL_SIZE, offsetY + y * CELL_SIZE, CELL_SIZE, CELL_SIZE};
-                if (grid[y][x].state == REVEALED) {
-                    if (grid[y][x].isMine) {
-                        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-                    } else {
-                        SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-                    }
-                } else {
-                    SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-                }
-                SDL_RenderFillRect(renderer, &cellRect);
-                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-                SDL_RenderDrawRect(renderer, &cellRect);
-
-                if (grid[y][x].state == REVEALED && grid[y][x].neighboringMines > 0 && !grid[y][x].isMine) {
-                    SDL_Color textColor;
-                    switch (grid[y][x].neighboringMines) {
-                        case 1: textColor = {0, 0, 255}; break;
-                        case 2: textColor = {0, 255, 0}; break;
-                        case 3: textColor = {255, 0, 0}; break;
-                        case 4: textColor = {0, 0, 128}; break;
-                        case 5: textColor = {128, 0, 0}; break;
-                        case 6: textColor = {0, 128, 128}; break;
-                        case 7: textColor = {0, 0, 0}; break;
-                        case 8: textColor = {128, 128, 128}; break;
-                        default: textColor = {0, 0, 0}; break;
-                    }
-                    std::string text = std::to_string(grid[y][x].neighboringMines);
-                    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), textColor);
-                    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-                    int textWidth = textSurface->w;
-                    int textHeight = textSurface->h;
-                    SDL_FreeSurface(textSurface);
-
-                    SDL_Rect textRect = {offsetX + x * CELL_SIZE + (CELL_SIZE - textWidth) / 2,
-                                         offsetY + y * CELL_SIZE + (CELL_SIZE - textHeight) / 2,
-                                         textWidth, textHeight};
-                    SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-                    SDL_DestroyTexture(textTexture);
-                } else if (grid[y][x].state == FLAGGED) {
-                    SDL_Color textColor = {255, 0, 0};
-                    SDL_Surface* textSurface = TTF_RenderText_Solid(font, "F", textColor);
-                    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-                    int textWidth = textSurface->w;
-                    int textHeight = textSurface->h;
-                    SDL_FreeSurface(textSurface);
-
-                    SDL_Rect textRect = {offsetX + x * CELL_SIZE + (CELL_SIZE - textWidth) / 2,
-                                         offsetY + y * CELL_SIZE + (CELL_SIZE - textHeight) / 2,
-                                         textWidth, textHeight};
-                    SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-                    SDL_DestroyTexture(textTexture);
-                }
-            }
-        }
+// Ligado pelo primeiro Ctrl+C: o treinamento termina a geração, grava o checkpoint e sai.
+volatile std::sig_atomic_t stopRequested = 0;
 
-        if (gameOver || youWin) {
-            SDL_Color textColor = gameOver ? SDL_Color{255, 0, 0, 255} : SDL_Color{0, 255, 0, 255};
-            std::string message = gameOver ? "Game Over!" : "You Win!";
-            SDL_Surface* textSurface = TTF_RenderText_Solid(font, message.c_str(), textColor);
-            SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-            int textWidth = textSurface->w;
-            int textHeight = textSurface->h;
-            SDL_FreeSurface(textSurface);
-
-            int windowWidth = GRID_WIDTH * CELL_SIZE;
-            int windowHeight = GRID_HEIGHT * CELL_SIZE;
-            SDL_Rect textRect = {offsetX + (windowWidth - textWidth) / 2,
-                                 offsetY + (windowHeight - textHeight) / 2,
-                                 textWidth, textHeight};
-            SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-            SDL_DestroyTexture(textTexture);
-        }
-    }
-};
+void handleInterrupt(int) {
+    stopRequested = 1;
+    std::signal(SIGINT, SIG_DFL); // Um segundo Ctrl+C encerra imediatamente.
+}
 
 /**
- * @enum RuleAction
- * @brief Define as duas possíveis ações que uma regra pode executar.
+ * @enum RandomStream
+ * @brief Identificadores dos fluxos aleatórios derivados de config.seed (ver rng.h).
+ * @details Cada fluxo é usado por uma única thread de cada vez: a seleção de cenários roda
+ * na thread principal, a visualização na sua própria thread (ver visualizer.h), e cada
+ * partida da avaliação e cada par de filhos da reprodução têm o seu próprio gerador, criado
+ * na pilha do worker que os processa.
  */
-enum RuleAction {
-    ACTION_REVEAL_HIDDEN,
-    ACTION_PLACE_FLAG
+enum RandomStream : uint64_t {
+    STREAM_INITIAL_POPULATION = 1, // População aleatória inicial.
+    STREAM_SCENARIO_BANK,          // Geração do banco de cenários.
+    STREAM_SCENARIO_SELECTION,     // Cenários sorteados em cada geração.
+    STREAM_BREEDING,               // Seleção, crossover e mutação de cada par de filhos.
+    STREAM_EVALUATION,             // Jogadas aleatórias em cada cenário do banco.
+    STREAM_VISUALIZATION,          // Jogadas aleatórias da visualização.
+    STREAM_ISLAND                  // Semente de cada ilha, derivada da semente mestra.
 };
 
-/**
- * @struct Rule
- * @brief Representa um único "gene" ou "instinto" de uma IA.
- * @details Contém um conjunto de condições e uma ação a ser tomada se todas as condições forem satisfeitas.
- */
-struct Rule {
-    int numberCondition;      // Condição: número na casa revelada.
-    int hiddenCondition;      // Condição: número de vizinhos ocultos.
-    int flaggedCondition;     // Condição: número de vizinhos com bandeira.
-    bool nearEdge;            // Condição: a casa está perto da borda?
-    bool hasSpecificPattern;  // Condição: um padrão específico foi detectado? (Placeholder)
-    int extendedScope;        // Condição: qual o tamanho da vizinhança a ser analisada?
-    int priority;             // Prioridade da regra (regras de maior prioridade são testadas primeiro).
-    RuleAction action;        // Ação a ser executada.
-};
+// === Estruturas e Enums Fundamentais ===
 
-/**
- * @struct Individual
- * @brief Representa uma única IA na população.
- */
-struct Individual {
-    std::vector<Rule> rules;  // O "cérebro" ou "DNA" do indivíduo, composto por um conjunto de regras.
-    double fitness = 0.0;     // Pontuação que mede o quão bem o indivíduo joga.
-};
+// Banco de cenários de teste, mapeado em memória a partir do arquivo (ver scenario_bank.h).
+ScenarioBank scenarioBank;
 
 /**
- * @struct FixedGame
- * @brief Armazena a configuração de um cenário de teste pré-definido.
+ * @struct EvaluationArena
+ * @brief Buffers da avaliação de fitness, alocados uma vez e reaproveitados em todas as gerações.
+ * @details Depois da primeira geração, o laço paralelo da avaliação não faz nenhuma
+ * alocação: os tabuleiros iniciais são reinicializados no lugar, cada worker joga sempre no
+ * mesmo tabuleiro de trabalho e os vetores de tarefas e pontuações mantêm sua capacidade.
  */
-struct FixedGame {
-    int startX;
-    int startY;
-    std::vector<std::vector<bool>> mineGrid; // Mapa exato da localização das minas.
+struct EvaluationArena {
+    std::vector<size_t> scenarioIndices; // Índice, no banco, de cada cenário da geração.
+    std::vector<Game> startBoards;  // Tabuleiro inicial de cada cenário da geração (ver buildStartBoards).
+    std::vector<uint64_t> scenarioSeeds; // Semente das jogadas aleatórias em cada cenário da geração.
+    std::vector<Game> workerBoards; // Um tabuleiro de trabalho por worker do pool.
+    std::vector<LockstepSimulator> workerSimulators; // Um simulador em lote por worker (config.lockstep).
+    std::vector<int> batchTasks;    // pendingTasks agrupados por cenário (config.lockstep).
+    std::vector<std::pair<int, int>> batches; // Lotes [início, fim) de batchTasks, um cenário por lote.
+    std::vector<int> scenarioStart; // Início dos pares de cada cenário em batchTasks (config.lockstep).
+    std::vector<int> scenarioFill;  // Próxima posição livre de cada cenário em batchTasks.
+    GpuEvaluator gpu;               // Backend de GPU (config.gpu).
+    std::vector<const RuleProgram *> gpuPrograms; // Programas enviados à GPU na rodada atual.
+    std::vector<int> gpuTaskProgram;  // Programa (em gpuPrograms) e cenário de cada par pendente.
+    std::vector<int> gpuTaskScenario;
+    std::vector<LaneResult> gpuResults;
+    std::vector<ScenarioScore> scores; // Resultado de cada par (indivíduo, cenário).
+    std::vector<int> pendingTasks;  // Pares que precisam ser jogados nesta geração.
+    std::vector<int> canonical;     // Primeiro indivíduo da população com o mesmo programa.
+    std::unordered_map<uint64_t, int> firstWithHash; // Auxiliar de `canonical`.
+    std::vector<int> alive;         // Indivíduos canônicos ainda na corrida.
+    std::vector<int> played;        // Cenários com resultado conhecido de cada indivíduo (prefixo da amostra).
+    std::vector<double> scoreSum;   // Soma das pontuações desses cenários.
+    std::vector<std::pair<double, int>> aliveMeans; // Auxiliar de racingReference.
+    std::vector<int> eliminated;    // Indivíduos eliminados pela corrida, na ordem de eliminação.
+    std::vector<int> raceReference; // Referência contra a qual cada eliminado foi comparado.
+    std::vector<double> raceDiff;   // Diferença pareada média do eliminado em relação à referência.
+    std::vector<double> fitness;    // Fitness final de cada indivíduo canônico.
+    FitnessCache fitnessCache;      // Pontuações de gerações anteriores.
+
+    explicit EvaluationArena(int workers)
+        : workerBoards(workers, Game(config.board.width, config.board.height, config.board.numMines)),
+          workerSimulators(workers, LockstepSimulator(config.board.width, config.board.height, config.board.numMines)) {}
 };
 
-// Variável global para armazenar todos os cenários de teste carregados do arquivo.
-std::vector<FixedGame> fixedGamesGlobal;
-
-
-// === Funções do Algoritmo Genético ===
-
 /**
- * @brief Cria um novo indivíduo com um conjunto de regras totalmente aleatórias.
- * @return Um objeto Individual.
+ * @brief Prepara o tabuleiro inicial de cada cenário selecionado.
+ * @details Os números e a abertura a partir do ponto de partida são calculados uma única vez
+ * por cenário; cada partida da geração começa copiando um destes tabuleiros (Game::loadState).
+ * Os tabuleiros de gerações anteriores são reaproveitados.
+ *
+ * A semente das jogadas aleatórias depende só do índice do cenário no banco: todos os
+ * indivíduos enfrentam o mesmo cenário com a mesma sequência de sorteios, então a pontuação
+ * de um genoma em um cenário é sempre a mesma e as comparações entre indivíduos não sofrem
+ * com o ruído do fallback aleatório.
+ * @param arena Buffers da avaliação; arena.startBoards e arena.scenarioSeeds ficam com uma
+ * entrada por cenário, na mesma ordem de selectedGames.
+ * @param selectedGames Índices, no banco, dos cenários de teste.
  */
-Individual createRandomIndividual() {
-    Individual ind;
-    ind.rules.resize(NUM_RULES);
-    std::uniform_int_distribution<> dis_num(0, 8);
-    std::uniform_int_distribution<> dis_hidden(0, 8);
-    std::uniform_int_distribution<> dis_flagged(0, 8);
-    std::uniform_int_distribution<> dis_bool(0, 1);
-    std::uniform_int_distribution<> dis_scope(1, 2);
-    std::uniform_int_distribution<> dis_priority(1, 10);
-
-    for(int i = 0; i < NUM_RULES; i++) {
-        ind.rules[i].numberCondition = dis_num(gen_global);
-        ind.rules[i].hiddenCondition = dis_hidden(gen_global);
-        ind.rules[i].flaggedCondition = dis_flagged(gen_global);
-        ind.rules[i].nearEdge = dis_bool(gen_global);
-        ind.rules[i].hasSpecificPattern = dis_bool(gen_global);
-        ind.rules[i].extendedScope = dis_scope(gen_global);
-        ind.rules[i].priority = dis_priority(gen_global);
-        ind.rules[i].action = (dis_bool(gen_global) == 0) ? ACTION_REVEAL_HIDDEN : ACTION_PLACE_FLAG;
+void buildStartBoards(EvaluationArena &arena, const std::vector<size_t> &selectedGames) {
+    std::vector<Game> &startBoards = arena.startBoards;
+    while (startBoards.size() < selectedGames.size()) {
+        startBoards.emplace_back(config.board.width, config.board.height, config.board.numMines);
+    }
+    startBoards.erase(startBoards.begin() + selectedGames.size(), startBoards.end());
+    arena.scenarioIndices = selectedGames;
+    arena.scenarioSeeds.resize(selectedGames.size());
+    for (size_t i = 0; i < selectedGames.size(); i++) {
+        Scenario scenario = scenarioBank.scenario(selectedGames[i]);
+        startBoards[i].initializeGridFixed(scenario.startX, scenario.startY, scenario.mineBits);
+        arena.scenarioSeeds[i] = deriveSeed(config.seed, {STREAM_EVALUATION, selectedGames[i]});
+    }
+
+    if (config.gpu) {
+        std::vector<Scenario> scenarios;
+        scenarios.reserve(selectedGames.size());
+        for (size_t index : selectedGames) scenarios.push_back(scenarioBank.scenario(index));
+        if (!arena.gpu.setScenarios(scenarios, arena.scenarioSeeds)) {
+            std::cerr << "Erro ao enviar os cenarios para a GPU; avaliando na CPU." << std::endl;
+            config.gpu = false;
+        }
     }
-    return ind;
 }
 
 /**
- * @brief Aplica o conjunto de regras de um indivíduo para jogar uma partida.
- * @param ind O indivíduo (IA) que está jogando.
- * @param game O estado atual do jogo.
- * @return true se alguma regra foi aplicada e uma ação foi tomada, false caso contrário.
+ * @brief Escolhe o indivíduo de referência da corrida: o último que ainda disputa os torneios.
+ * @details Em um torneio de k indivíduos, o indivíduo na posição r (fração r/N da população)
+ * só vence se os outros k - 1 sorteados forem piores, o que acontece com probabilidade
+ * (1 - r/N)^(k-1). A referência é o indivíduo vivo, em ordem de média, na posição em que
+ * essa chance cai abaixo de 1%; os elites estão sempre acima dela.
+ * @param arena Buffers da avaliação (usa arena.aliveMeans como auxiliar).
+ * @param candidates Índices dos indivíduos ainda na corrida.
+ * @param populationSize Tamanho da população.
+ * @return O índice, na população, do indivíduo de referência.
  */
-bool applyRules(Individual &ind, Game &game) {
-    bool changed = false;
-    std::vector<Rule> sortedRules = ind.rules;
-    std::sort(sortedRules.begin(), sortedRules.end(), [](const Rule &a, const Rule &b) {
-        return a.priority > b.priority;
-    });
-
-    for(auto &rule : sortedRules) {
-        if (game.gameOver || game.youWin) return changed;
-
-        for(int y = 0; y < GRID_HEIGHT; y++) {
-            for(int x = 0; x < GRID_WIDTH; x++) {
-                if (game.gameOver || game.youWin) return changed;
-                if(game.grid[y][x].state == REVEALED && game.grid[y][x].neighboringMines == rule.numberCondition) {
-                    int flagsCount = 0;
-                    int hiddenCount = 0;
-                    std::vector<std::pair<int, int>> hiddenCells;
-
-                    for(int dy = -rule.extendedScope; dy <= rule.extendedScope; dy++) {
-                        for(int dx = -rule.extendedScope; dx <= rule.extendedScope; dx++) {
-                            int nx = x + dx;
-                            int ny = y + dy;
-                            if(nx <0 || nx >= GRID_WIDTH || ny <0 || ny >= GRID_HEIGHT) continue;
-                            if(game.grid[ny][nx].state == FLAGGED) flagsCount++;
-                            if(game.grid[ny][nx].state == HIDDEN) {
-                                hiddenCount++;
-                                hiddenCells.emplace_back(nx, ny);
-                            }
-                        }
-                    }
-
-                    if(hiddenCount != rule.hiddenCondition) continue;
-                    if(flagsCount != rule.flaggedCondition) continue;
-                    if(rule.nearEdge) {
-                        bool isNearEdge = (x <=1 || x >= GRID_WIDTH-2 || y <=1 || y >= GRID_HEIGHT-2);
-                        if(!isNearEdge) continue;
-                    }
-                    if(rule.hasSpecificPattern) {
-                        bool patternDetected = false;
-                        if(game.grid[y][x].neighboringMines == 2) {
-                            patternDetected = true;
-                        }
-                        if(!patternDetected) continue;
-                    }
-
-                    if(rule.action == ACTION_REVEAL_HIDDEN) {
-                        if(flagsCount == rule.numberCondition && hiddenCount > 0) {
-                            for(auto &c : hiddenCells) {
-                                if(!game.gameOver && !game.youWin) {
-                                    game.revealCell(c.first, c.second);
-                                    changed = true;
-                                }
-                            }
-                        }
-                    } else if(rule.action == ACTION_PLACE_FLAG) {
-                        if((rule.numberCondition - 1) == flagsCount && hiddenCount == 1) {
-                            if(!game.gameOver && !game.youWin) {
-                                game.placeFlag(hiddenCells[0].first, hiddenCells[0].second);
-                                changed = true;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-    return changed;
+int racingReference(EvaluationArena &arena, const std::vector<int> &candidates, size_t populationSize) {
+    auto &means = arena.aliveMeans;
+    means.clear();
+    for (int i : candidates) means.emplace_back(arena.scoreSum[i] / arena.played[i], i);
+
+    const double contention = 1.0 - std::pow(0.01, 1.0 / std::max(1, config.tournamentSize - 1));
+    size_t rank = std::max<size_t>(2, static_cast<size_t>(std::ceil(contention * populationSize)));
+    rank = std::min(rank, means.size()) - 1;
+    std::nth_element(means.begin(), means.begin() + rank, means.end(), std::greater<std::pair<double, int>>());
+    return means[rank].second;
 }
 
 /**
- * @brief Revela uma célula oculta aleatória. Usado como fallback quando a IA fica presa.
+ * @brief Joga os pares pendentes da rodada na GPU (config.gpu) e preenche arena.scores.
+ * @details Cada indivíduo pendente entra uma única vez na tabela de programas enviada ao
+ * kernel. Em caso de erro do OpenCL, desliga o backend e devolve false: a rodada (e o resto
+ * do treinamento) é jogada na CPU.
  */
-void revealRandomCell(Game &game) {
-    std::vector<std::pair<int, int>> hiddenCells;
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            if (game.grid[y][x].state == HIDDEN) {
-                hiddenCells.emplace_back(x, y);
-            }
-        }
+bool playPendingOnGpu(const std::vector<Individual> &population, EvaluationArena &arena, int gamesPerIndividual) {
+    arena.gpuPrograms.clear();
+    arena.gpuTaskProgram.clear();
+    arena.gpuTaskScenario.clear();
+    int lastIndividual = -1;
+    for (int task : arena.pendingTasks) {
+        const int i = task / gamesPerIndividual;
+        if (i != lastIndividual) {
+            arena.gpuPrograms.push_back(&population[i].program);
+            lastIndividual = i;
+        }
+        arena.gpuTaskProgram.push_back(static_cast<int>(arena.gpuPrograms.size()) - 1);
+        arena.gpuTaskScenario.push_back(task % gamesPerIndividual);
+    }
+    if (!arena.gpu.play(arena.gpuPrograms, arena.gpuTaskProgram, arena.gpuTaskScenario, arena.gpuResults)) {
+        std::cerr << "Erro na avaliacao em GPU; avaliando na CPU." << std::endl;
+        config.gpu = false;
+        return false;
     }
-
-    if (!hiddenCells.empty()) {
-        std::uniform_int_distribution<> dis(0, hiddenCells.size() - 1);
-        int idx = dis(gen_global);
-        game.revealCell(hiddenCells[idx].first, hiddenCells[idx].second);
+    for (size_t k = 0; k < arena.pendingTasks.size(); k++) {
+        const LaneResult &r = arena.gpuResults[k];
+        arena.scores[arena.pendingTasks[k]] = scoreScenario(r.revealedSafe, r.correctFlags, r.minesRevealed, r.actionsTaken, r.won);
     }
+    return true;
 }
 
 /**
- * @brief Avalia o desempenho de um indivíduo em um conjunto de cenários de teste.
- * @details Calcula a pontuação de fitness com base em células seguras reveladas, bandeiras corretas,
- * penalidades por erros e um grande bônus por vitória.
- * @param ind O indivíduo a ser avaliado.
- * @param selectedGames O conjunto de cenários de teste para esta avaliação.
- * @param generationWins Contador atômico para o total de vitórias na geração.
- * @param generationGames Contador atômico para o total de jogos na geração.
- * @return O valor médio de fitness do indivíduo nos cenários.
+ * @brief Avalia toda a população em paralelo no pool de threads.
+ * @details Cada tarefa é um par (indivíduo, cenário), não um indivíduo inteiro, para que
+ * os workers se equilibrem mesmo quando algumas partidas são muito mais longas que outras.
+ * As pontuações são somadas na ordem dos cenários, então o resultado não depende do
+ * número de threads. Cada worker joga em seu próprio tabuleiro de trabalho, recarregado a
+ * partir de arena.startBoards no início de cada partida.
+ *
+ * Com config.lockstep (padrão), a tarefa passa a ser um lote de até LockstepSimulator::LANES
+ * indivíduos em um mesmo cenário, jogados juntos pelo simulador em lote do worker; as
+ * pontuações são as mesmas da avaliação partida a partida. Com config.gpu, os pares
+ * pendentes de cada rodada são jogados de uma vez na GPU (ver playPendingOnGpu).
+ *
+ * Antes de cada laço paralelo, os pares já conhecidos são respondidos pelo cache de fitness
+ * (config.fitnessCache) e indivíduos com o mesmo programa de regras jogam uma única vez;
+ * só os pares restantes viram tarefas. O resultado é o mesmo de jogar todos os pares.
+ *
+ * No modo de corrida (config.racing), os cenários são jogados em rodadas de
+ * config.racingRound. Depois de cada rodada, cada indivíduo é comparado com a referência
+ * de racingReference() cenário a cenário: como todos jogam os mesmos cenários com os mesmos
+ * sorteios, a diferença pareada elimina a variação de dificuldade entre cenários. Se o
+ * limite superior da diferença média (média + racingZ * erro padrão) for negativo, o
+ * indivíduo sai da corrida. Os demais seguem para a próxima rodada, até completar a amostra
+ * da geração. A média crua dos cenários que o eliminado jogou não é comparável com a média
+ * da amostra inteira (as primeiras rodadas podem ter sido fáceis), então seu fitness é o da
+ * referência na escala final mais a diferença pareada medida, limitado a ficar abaixo do
+ * pior sobrevivente.
+ * @return O número de partidas efetivamente jogadas.
  */
-double evaluateIndividual(Individual &ind, const std::vector<FixedGame> &selectedGames, std::atomic<int> &generationWins, std::atomic<int> &generationGames) {
-    double totalScore = 0.0;
-
-    for(const auto &fg : selectedGames) {
-        Game game;
-        game.initializeGridFixed(fg.startX, fg.startY, fg.mineGrid);
-
-        int actionsTaken = 0;
-        bool changed = true;
-        while(!game.gameOver && !game.youWin && changed) {
-            changed = applyRules(ind, game);
-            if(changed) {
-                actionsTaken++;
-            }
-            if(!changed && !game.gameOver && !game.youWin) {
-                revealRandomCell(game);
-                actionsTaken++;
-                changed = true;
+int evaluatePopulation(ThreadPool &pool, std::vector<Individual> &population, EvaluationArena &arena,
+                       std::atomic<int> &generationWins, std::atomic<int> &generationGames) {
+    const std::vector<Game> &startBoards = arena.startBoards;
+    std::vector<Game> &workerBoards = arena.workerBoards;
+    std::vector<ScenarioScore> &scores = arena.scores;
+    std::vector<int> &pending = arena.pendingTasks;
+    std::vector<int> &canonical = arena.canonical;
+    FitnessCache &cache = arena.fitnessCache;
+    const int gamesPerIndividual = static_cast<int>(startBoards.size());
+    if (gamesPerIndividual == 0) return 0;
+    scores.assign(population.size() * gamesPerIndividual, ScenarioScore());
+
+    // Indivíduos com o mesmo programa jogam de forma idêntica: só o primeiro é avaliado.
+    canonical.resize(population.size());
+    arena.firstWithHash.clear();
+    std::vector<int> &alive = arena.alive;
+    alive.clear();
+    for (size_t i = 0; i < population.size(); ++i) {
+        auto inserted = arena.firstWithHash.emplace(population[i].program.hash, static_cast<int>(i));
+        const int first = inserted.first->second;
+        canonical[i] = (inserted.second || !sameProgram(population[first].program, population[i].program))
+                       ? static_cast<int>(i) : first;
+        if (canonical[i] == static_cast<int>(i)) alive.push_back(static_cast<int>(i));
+    }
+    arena.played.assign(population.size(), 0);
+    arena.scoreSum.assign(population.size(), 0.0);
+    arena.eliminated.clear();
+    arena.raceReference.assign(population.size(), -1);
+    arena.raceDiff.assign(population.size(), 0.0);
+
+    if (config.fitnessCache) cache.retain(population);
+    const int roundSize = config.racing ? config.racingRound : gamesPerIndividual;
+    int gamesPlayed = 0;
+    for (int begin = 0; begin < gamesPerIndividual && !alive.empty(); begin += roundSize) {
+        const int end = std::min(gamesPerIndividual, begin + roundSize);
+        pending.clear();
+        for (int i : alive) {
+            for (int g = begin; g < end; ++g) {
+                const int task = i * gamesPerIndividual + g;
+                const ScenarioScore *cached = config.fitnessCache ? cache.find(population[i].program, arena.scenarioIndices[g]) : nullptr;
+                if (cached) scores[task] = *cached;
+                else pending.push_back(task);
             }
         }
 
-        int safeRevealed = 0;
-        int correctFlags = 0;
-        int minesRevealed = 0;
-
-        for(int y = 0; y < GRID_HEIGHT; y++) {
-            for(int x = 0; x < GRID_WIDTH; x++) {
-                if(!game.grid[y][x].isMine && game.grid[y][x].state == REVEALED) {
-                    safeRevealed++;
+        if (config.gpu && playPendingOnGpu(population, arena, gamesPerIndividual)) {
+            // Todos os pares pendentes foram jogados na GPU.
+        } else if (config.lockstep) {
+            // Reagrupa os pares por cenário (ordem estável entre indivíduos): lotes de até
+            // LANES indivíduos jogando o mesmo cenário.
+            std::vector<int> &byScenario = arena.batchTasks;
+            std::vector<std::pair<int, int>> &batches = arena.batches;
+            std::vector<int> &scenarioStart = arena.scenarioStart;
+            scenarioStart.assign(gamesPerIndividual + 1, 0);
+            for (int task : pending) scenarioStart[task % gamesPerIndividual + 1]++;
+            for (int g = 0; g < gamesPerIndividual; g++) scenarioStart[g + 1] += scenarioStart[g];
+            byScenario.resize(pending.size());
+            std::vector<int> &fill = arena.scenarioFill;
+            fill.assign(scenarioStart.begin(), scenarioStart.end() - 1);
+            for (int task : pending) byScenario[fill[task % gamesPerIndividual]++] = task;
+            batches.clear();
+            for (int g = 0; g < gamesPerIndividual; g++) {
+                for (int p = scenarioStart[g]; p < scenarioStart[g + 1]; p += LockstepSimulator::LANES) {
+                    batches.emplace_back(p, std::min(p + LockstepSimulator::LANES, scenarioStart[g + 1]));
                 }
-                if(game.grid[y][x].isMine && game.grid[y][x].state == FLAGGED) {
-                    correctFlags++;
-                }
-                if(game.grid[y][x].isMine && game.grid[y][x].state == REVEALED) {
-                    minesRevealed++;
+            }
+            pool.parallelFor(static_cast<int>(batches.size()), 0, [&](int worker, int b) {
+                const int first = batches[b].first;
+                const int count = batches[b].second - first;
+                const int g = byScenario[first] % gamesPerIndividual;
+                const RuleProgram *programs[LockstepSimulator::LANES];
+                for (int k = 0; k < count; k++) programs[k] = &population[byScenario[first + k] / gamesPerIndividual].program;
+                LockstepSimulator &simulator = arena.workerSimulators[worker];
+                simulator.load(startBoards[g], arena.scenarioSeeds[g], programs, count);
+                LaneResult results[LockstepSimulator::LANES];
+                simulator.play(results);
+                for (int k = 0; k < count; k++) {
+                    const LaneResult &r = results[k];
+                    scores[byScenario[first + k]] = scoreScenario(r.revealedSafe, r.correctFlags, r.minesRevealed, r.actionsTaken, r.won);
                 }
+            });
+        } else {
+            pool.parallelFor(static_cast<int>(pending.size()), 0, [&](int worker, int p) {
+                const int task = pending[p];
+                const Individual &ind = population[task / gamesPerIndividual];
+                const int g = task % gamesPerIndividual;
+                scores[task] = evaluateScenario(ind, startBoards[g], arena.scenarioSeeds[g], workerBoards[worker]);
+            });
+        }
+        gamesPlayed += static_cast<int>(pending.size());
+
+        if (config.fitnessCache) {
+            for (int task : pending) {
+                cache.store(population[task / gamesPerIndividual].program, arena.scenarioIndices[task % gamesPerIndividual], scores[task]);
             }
         }
 
-        double score = safeRevealed;
-        score += correctFlags * 5.0;
-        score -= minesRevealed * 50.0;
-        score -= actionsTaken * 0.1;
-
-        if(game.youWin) {
-            score += 2000.0;
-            generationWins++;
+        for (int i : alive) {
+            for (int g = begin; g < end; ++g) arena.scoreSum[i] += scores[i * gamesPerIndividual + g].score;
+            arena.played[i] = end;
         }
 
-        generationGames++;
-        totalScore += score;
-    }
-
-    return totalScore / selectedGames.size();
+        // Corrida: descarta quem fica abaixo da referência mesmo no limite superior da diferença.
+        if (!config.racing || end == gamesPerIndividual || end < 2 || alive.size() <= 2) continue;
+        const int reference = racingReference(arena, alive, population.size());
+        const ScenarioScore *refScores = &scores[reference * gamesPerIndividual];
+        alive.erase(std::remove_if(alive.begin(), alive.end(), [&](int i) {
+            const ScenarioScore *own = &scores[i * gamesPerIndividual];
+            double sum = 0.0, sumSq = 0.0;
+            for (int g = 0; g < end; ++g) {
+                const double d = own[g].score - refScores[g].score;
+                sum += d;
+                sumSq += d * d;
+            }
+            const double mean = sum / end;
+            const double variance = std::max(0.0, (sumSq - sum * mean) / (end - 1));
+            if (mean + config.racingZ * std::sqrt(variance / end) >= 0.0) return false;
+            arena.eliminated.push_back(i);
+            arena.raceReference[i] = reference;
+            arena.raceDiff[i] = mean;
+            return true;
+        }), alive.end());
+    }
+
+    // Sobreviventes: média da amostra inteira. Eliminados: fitness final da referência mais a
+    // diferença pareada. A referência de um eliminado sobreviveu ou foi eliminada depois dele,
+    // então percorrer os eliminados de trás para frente sempre encontra o fitness dela pronto.
+    std::vector<double> &fitness = arena.fitness;
+    fitness.assign(population.size(), 0.0);
+    double worstSurvivor = std::numeric_limits<double>::infinity();
+    for (int i : alive) {
+        fitness[i] = arena.scoreSum[i] / arena.played[i];
+        worstSurvivor = std::min(worstSurvivor, fitness[i]);
+    }
+    double bestEliminated = -std::numeric_limits<double>::infinity();
+    for (auto it = arena.eliminated.rbegin(); it != arena.eliminated.rend(); ++it) {
+        fitness[*it] = fitness[arena.raceReference[*it]] + arena.raceDiff[*it];
+        bestEliminated = std::max(bestEliminated, fitness[*it]);
+    }
+    // Nenhum eliminado pode ficar à frente de um sobrevivente: se isso acontecer (a diferença
+    // foi medida só no início da amostra), todos descem juntos, mantendo a ordem entre eles.
+    if (!arena.eliminated.empty() && bestEliminated >= worstSurvivor) {
+        const double shift = bestEliminated - worstSurvivor;
+        const double below = std::nextafter(worstSurvivor, -std::numeric_limits<double>::infinity());
+        for (int i : arena.eliminated) fitness[i] = std::min(fitness[i] - shift, below);
+    }
+
+    int wins = 0;
+    int games = 0;
+    for (size_t i = 0; i < population.size(); ++i) {
+        const int source = canonical[i];
+        const int n = arena.played[source];
+        for (int g = 0; g < n; ++g) {
+            if (scores[source * gamesPerIndividual + g].won) wins++;
+        }
+        games += n;
+        population[i].fitness = fitness[source];
+    }
+    generationWins += wins;
+    generationGames += games;
+    return gamesPlayed;
 }
 
-/**
- * @brief Calcula a distância genética entre dois indivíduos. Usado no niching.
- */
-double calculateGeneticDistance(const Individual &a, const Individual &b) {
-    int distance = 0;
-    for(int i = 0; i < NUM_RULES; i++) {
-        if(a.rules[i].numberCondition != b.rules[i].numberCondition) distance++;
-        if(a.rules[i].hiddenCondition != b.rules[i].hiddenCondition) distance++;
-        if(a.rules[i].flaggedCondition != b.rules[i].flaggedCondition) distance++;
-        if(a.rules[i].nearEdge != b.rules[i].nearEdge) distance++;
-        if(a.rules[i].hasSpecificPattern != b.rules[i].hasSpecificPattern) distance++;
-        if(a.rules[i].extendedScope != b.rules[i].extendedScope) distance++;
-        if(a.rules[i].action != b.rules[i].action) distance++;
-    }
-    return static_cast<double>(distance) / (NUM_RULES * 7.0); // Normalizado
-}
+// === Funções de Persistência e Arquivos ===
 
 /**
- * @brief Seleciona um indivíduo da população para ser um "pai".
- * @details Usa o método de seleção por torneio. Um número de indivíduos (TOURNAMENT_SIZE)
- * é escolhido aleatoriamente, e o de maior fitness vence, sendo selecionado para reprodução.
- * Inclui uma forma simples de "niching" para favorecer a diversidade.
- * @param pop A população atual.
- * @return O indivíduo selecionado.
+ * @brief Sorteia, sem repetição, os índices dos cenários do banco usados na geração atual.
+ * @details Usa o algoritmo de Floyd, que custa O(numGames) independentemente do tamanho do
+ * banco. Os índices são devolvidos em ordem crescente, para que a avaliação percorra o
+ * mapeamento do arquivo em sequência.
+ * @param numGames O número de jogos a serem selecionados.
+ * @param rng Gerador do fluxo de seleção de cenários da geração.
+ * @return Os índices dos cenários selecionados.
  */
-Individual tournamentSelection(const std::vector<Individual> &pop) {
-    std::uniform_int_distribution<> dis(0, static_cast<int>(pop.size()) - 1);
-    Individual best = pop[dis(gen_global)];
-
-    for(int i = 1; i < TOURNAMENT_SIZE; i++) {
-        Individual competitor = pop[dis(gen_global)];
-        if(competitor.fitness > best.fitness) {
-            best = competitor;
-        }
-    }
-    return best;
+std::vector<size_t> selectFixedGames(int numGames, Xoshiro256 &rng) {
+    std::vector<size_t> selectedGames;
+    const size_t bankSize = scenarioBank.size();
+    if (bankSize == 0) return selectedGames;
+
+    const size_t wanted = std::min(static_cast<size_t>(numGames), bankSize);
+    std::unordered_set<size_t> chosen;
+    for (size_t j = bankSize - wanted; j < bankSize; j++) {
+        size_t t = std::uniform_int_distribution<size_t>(0, j)(rng);
+        chosen.insert(chosen.count(t) ? j : t);
+    }
+    selectedGames.assign(chosen.begin(), chosen.end());
+    std::sort(selectedGames.begin(), selectedGames.end());
+    return selectedGames;
 }
 
 /**
- * @brief Realiza o cruzamento (reprodução) entre dois pais para gerar dois filhos.
- * @details Utiliza a técnica de crossover de múltiplos pontos, misturando os "genes" (regras)
- * dos pais em vários locais aleatórios para criar os filhos.
+ * @brief Grava no registro as partidas do melhor indivíduo nos cenários da geração.
+ * @details As partidas são jogadas de novo pelo caminho escalar (recordScenario), com o mesmo
+ * resultado da avaliação: custa config.gamesPerGeneration partidas na thread principal.
+ * @param board Tabuleiro de trabalho (dimensões de config.board).
  */
-void crossover(const Individual &p1, const Individual &p2, Individual &o1, Individual &o2) {
-    std::uniform_int_distribution<> dis_points(1, NUM_RULES - 1);
-    int numPoints = dis_points(gen_global);
-    std::vector<int> points;
-    while(points.size() < static_cast<size_t>(numPoints)) {
-        int point = dis_points(gen_global);
-        if(std::find(points.begin(), points.end(), point) == points.end()) {
-            points.push_back(point);
-        }
-    }
-    std::sort(points.begin(), points.end());
-
-    o1.rules.resize(NUM_RULES);
-    o2.rules.resize(NUM_RULES);
-    int last = 0;
-    bool toggle = false;
-    for(auto point : points) {
-        for(int i = last; i < point; i++) {
-            if(toggle) {
-                o1.rules[i] = p2.rules[i];
-                o2.rules[i] = p1.rules[i];
-            } else {
-                o1.rules[i] = p1.rules[i];
-                o2.rules[i] = p2.rules[i];
-            }
-        }
-        toggle = !toggle;
-        last = point;
-    }
-    for(int i = last; i < NUM_RULES; i++) {
-        if(toggle) {
-            o1.rules[i] = p2.rules[i];
-            o2.rules[i] = p1.rules[i];
-        } else {
-            o1.rules[i] = p1.rules[i];
-            o2.rules[i] = p2.rules[i];
-        }
-    }
+void recordGeneration(ReplayWriter &writer, const Individual &best, const EvaluationArena &arena, Game &board, int generation) {
+    const size_t mineBytes = (static_cast<size_t>(config.board.width) * config.board.height + 7) / 8;
+    ReplayGame replay;
+    replay.generation = generation;
+    for (size_t g = 0; g < arena.startBoards.size(); g++) {
+        const Scenario scenario = scenarioBank.scenario(arena.scenarioIndices[g]);
+        const ScenarioScore result = recordScenario(best, arena.startBoards[g], arena.scenarioSeeds[g], board, replay.moves);
+        replay.scenario = static_cast<int>(arena.scenarioIndices[g]);
+        replay.startX = scenario.startX;
+        replay.startY = scenario.startY;
+        replay.won = result.won;
+        replay.score = result.score;
+        replay.mineBits.assign(scenario.mineBits, scenario.mineBits + mineBytes);
+        writer.append(replay);
+    }
+    writer.flush();
 }
 
-/**
- * @brief Aplica mutações aleatórias a um indivíduo.
- * @details Percorre cada "gene" (valor dentro de uma regra) e, com uma pequena probabilidade
- * (MUTATION_RATE), o altera para um novo valor aleatório. É a fonte de inovação genética.
- */
-void mutate(Individual &ind) {
-    std::uniform_real_distribution<> dis_real(0.0, 1.0);
-    std::uniform_int_distribution<> dis_num(0, 8);
-    std::uniform_int_distribution<> dis_hidden(0, 8);
-    std::uniform_int_distribution<> dis_flagged(0, 8);
-    std::uniform_int_distribution<> dis_bool(0, 1);
-    std::uniform_int_distribution<> dis_scope(1, 2);
-    std::uniform_int_distribution<> dis_priority(1, 10);
-
-    for(auto &rule : ind.rules) {
-        if(dis_real(gen_global) < MUTATION_RATE) rule.numberCondition = dis_num(gen_global);
-        if(dis_real(gen_global) < MUTATION_RATE) rule.hiddenCondition = dis_hidden(gen_global);
-        if(dis_real(gen_global) < MUTATION_RATE) rule.flaggedCondition = dis_flagged(gen_global);
-        if(dis_real(gen_global) < MUTATION_RATE) rule.nearEdge = dis_bool(gen_global);
-        if(dis_real(gen_global) < MUTATION_RATE) rule.hasSpecificPattern = dis_bool(gen_global);
-        if(dis_real(gen_global) < MUTATION_RATE) rule.extendedScope = dis_scope(gen_global);
-        if(dis_real(gen_global) < MUTATION_RATE) rule.priority = dis_priority(gen_global);
-        if(dis_real(gen_global) < MUTATION_RATE) rule.action = (dis_bool(gen_global) == 0) ? ACTION_REVEAL_HIDDEN : ACTION_PLACE_FLAG;
-    }
-}
-
-// === Funções de Persistência e Arquivos ===
+// === Configuração ===
 
 /**
- * @brief Salva o estado atual da população em um arquivo binário.
- * @details Salva cada membro das estruturas individualmente para garantir compatibilidade.
- * @param population O vetor de indivíduos a ser salvo.
- * @param filename O nome do arquivo (ex: "populacao_regras.dat").
+ * @brief Preenche a configuração do treinamento a partir da linha de comando e/ou arquivo.
+ * @details Chaves aceitas (além das do tabuleiro: board, width, height, mines):
+ * population, rules, mutation-rate, crossover-rate, tournament, fixed-games,
+ * games-per-generation, fitness-cache, racing, racing-round, racing-z, lockstep, gpu, gpu-device, threads, display, population-file, fixed-games-file, seed,
+ * islands, island, migration-interval, migrants, migration-dir, checkpoint-interval, checkpoint-history,
+ * replay-file, replay-interval,
+ * profile, profile-trace, profile-trace-generations.
+ * @return false se algum parâmetro for inválido (a mensagem de erro já foi impressa).
  */
-void savePopulation(const std::vector<Individual> &population, const std::string &filename) {
-    std::ofstream ofs(filename, std::ios::binary);
-    if(!ofs) {
-        std::cerr << "Erro ao salvar a populacao em " << filename << std::endl;
-        return;
-    }
-    int popSize = static_cast<int>(population.size());
-    ofs.write(reinterpret_cast<const char*>(&popSize), sizeof(popSize));
-    for(const auto &ind : population) {
-        int numRules = static_cast<int>(ind.rules.size());
-        ofs.write(reinterpret_cast<const char*>(&numRules), sizeof(numRules));
-        for(const auto &rule : ind.rules) {
-            // Salva cada membro da regra individualmente
-            ofs.write(reinterpret_cast<const char*>(&rule.numberCondition), sizeof(rule.numberCondition));
-            ofs.write(reinterpret_cast<const char*>(&rule.hiddenCondition), sizeof(rule.hiddenCondition));
-            ofs.write(reinterpret_cast<const char*>(&rule.flaggedCondition), sizeof(rule.flaggedCondition));
-            ofs.write(reinterpret_cast<const char*>(&rule.nearEdge), sizeof(rule.nearEdge));
-            ofs.write(reinterpret_cast<const char*>(&rule.hasSpecificPattern), sizeof(rule.hasSpecificPattern));
-            ofs.write(reinterpret_cast<const char*>(&rule.extendedScope), sizeof(rule.extendedScope));
-            ofs.write(reinterpret_cast<const char*>(&rule.priority), sizeof(rule.priority));
-            ofs.write(reinterpret_cast<const char*>(&rule.action), sizeof(rule.action));
+bool readTrainingConfig(const Options &options, TrainingConfig &cfg) {
+    if (!readBoardConfig(options, cfg.board, cfg.board)) return false;
+    cfg.populationSize = options.getInt("population", cfg.populationSize);
+    cfg.numRules = options.getInt("rules", cfg.numRules);
+    cfg.mutationRate = options.getDouble("mutation-rate", cfg.mutationRate);
+    cfg.crossoverRate = options.getDouble("crossover-rate", cfg.crossoverRate);
+    cfg.tournamentSize = options.getInt("tournament", cfg.tournamentSize);
+    cfg.fixedGameCount = options.getInt("fixed-games", cfg.fixedGameCount);
+    cfg.gamesPerGeneration = options.getInt("games-per-generation", cfg.gamesPerGeneration);
+    cfg.fitnessCache = options.getBool("fitness-cache", cfg.fitnessCache);
+    cfg.racing = options.getBool("racing", cfg.racing);
+    cfg.racingRound = options.getInt("racing-round", cfg.racingRound);
+    cfg.racingZ = options.getDouble("racing-z", cfg.racingZ);
+    cfg.lockstep = options.getBool("lockstep", cfg.lockstep);
+    cfg.gpu = options.getBool("gpu", cfg.gpu);
+    cfg.gpuDevice = options.getInt("gpu-device", cfg.gpuDevice);
+    cfg.islands.count = options.getInt("islands", cfg.islands.count);
+    cfg.islands.id = options.getInt("island", cfg.islands.id);
+    cfg.islands.interval = options.getInt("migration-interval", cfg.islands.interval);
+    cfg.islands.migrants = options.getInt("migrants", cfg.islands.migrants);
+    cfg.islands.directory = options.getString("migration-dir", cfg.islands.directory);
+    cfg.numThreads = options.getInt("threads", cfg.numThreads);
+    cfg.individualsToDisplay = options.getInt("display", cfg.individualsToDisplay);
+    cfg.populationFile = options.getString("population-file", cfg.populationFile);
+    cfg.fixedGamesFile = options.getString("fixed-games-file", cfg.fixedGamesFile);
+    cfg.checkpointInterval = options.getInt("checkpoint-interval", cfg.checkpointInterval);
+    cfg.checkpointHistory = options.getInt("checkpoint-history", cfg.checkpointHistory);
+    cfg.replayFile = options.getString("replay-file", cfg.replayFile);
+    cfg.replayInterval = options.getInt("replay-interval", cfg.replayInterval);
+    cfg.profileFile = options.getString("profile", cfg.profileFile);
+    cfg.traceFile = options.getString("profile-trace", cfg.traceFile);
+    cfg.traceGenerations = options.getInt("profile-trace-generations", cfg.traceGenerations);
+    if (options.has("seed")) {
+        const std::string text = options.getString("seed", "");
+        size_t used = 0;
+        try {
+            cfg.seed = std::stoull(text, &used);
+        } catch (const std::exception &) {
+            used = 0;
+        }
+        if (used == 0 || used != text.size()) {
+            std::cerr << "--seed deve ser um inteiro sem sinal (recebido: '" << text << "')." << std::endl;
+            return false;
         }
-        ofs.write(reinterpret_cast<const char*>(&ind.fitness), sizeof(ind.fitness));
+    } else {
+        std::random_device rd;
+        cfg.seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
     }
-    ofs.close();
-}
 
-/**
- * @brief Carrega uma população previamente salva de um arquivo binário.
- * @details Lê cada membro das estruturas individualmente para garantir compatibilidade.
- * @return true se o carregamento for bem-sucedido, false caso contrário.
- */
-bool loadPopulation(std::vector<Individual> &population, const std::string &filename) {
-    std::ifstream ifs(filename, std::ios::binary);
-    if(!ifs) return false;
-
-    int popSize;
-    ifs.read(reinterpret_cast<char*>(&popSize), sizeof(popSize));
-    if (ifs.fail() || popSize != POPULATION_SIZE) {
-        if (!ifs.fail()) std::cerr << "AVISO: O tamanho da populacao no arquivo (" << popSize << ") e diferente do parametro atual (" << POPULATION_SIZE << "). Iniciando do zero." << std::endl;
+    if (cfg.populationSize < 2 || cfg.numRules < 2 || cfg.tournamentSize < 1 ||
+        cfg.fixedGameCount < 1 || cfg.gamesPerGeneration < 1 || cfg.numThreads < 0 || cfg.individualsToDisplay < 0 ||
+        cfg.racingRound < 1 || cfg.racingZ < 0.0 || cfg.checkpointInterval < 1 || cfg.checkpointHistory < 0 ||
+        cfg.replayInterval < 1) {
+        std::cerr << "Parametros do treinamento invalidos (population >= 2, rules >= 2, tournament/fixed-games/"
+                     "games-per-generation/racing-round/checkpoint-interval/replay-interval >= 1, threads/display/racing-z/"
+                     "checkpoint-history >= 0)." << std::endl;
         return false;
     }
-
-    population.assign(popSize, Individual());
-    for(int i = 0; i < popSize; i++) {
-        int numRules;
-        ifs.read(reinterpret_cast<char*>(&numRules), sizeof(numRules));
-        if (ifs.fail() || numRules != NUM_RULES) {
-            if(!ifs.fail()) std::cerr << "AVISO: O numero de regras no arquivo (" << numRules << ") e diferente do parametro atual (" << NUM_RULES << "). Iniciando do zero." << std::endl;
-            return false;
-        }
-        population[i].rules.resize(numRules);
-        for(int j = 0; j < numRules; j++) {
-            // Lê cada membro da regra individualmente
-            Rule& rule = population[i].rules[j];
-            ifs.read(reinterpret_cast<char*>(&rule.numberCondition), sizeof(rule.numberCondition));
-            ifs.read(reinterpret_cast<char*>(&rule.hiddenCondition), sizeof(rule.hiddenCondition));
-            ifs.read(reinterpret_cast<char*>(&rule.flaggedCondition), sizeof(rule.flaggedCondition));
-            ifs.read(reinterpret_cast<char*>(&rule.nearEdge), sizeof(rule.nearEdge));
-            ifs.read(reinterpret_cast<char*>(&rule.hasSpecificPattern), sizeof(rule.hasSpecificPattern));
-            ifs.read(reinterpret_cast<char*>(&rule.extendedScope), sizeof(rule.extendedScope));
-            ifs.read(reinterpret_cast<char*>(&rule.priority), sizeof(rule.priority));
-            ifs.read(reinterpret_cast<char*>(&rule.action), sizeof(rule.action));
-        }
-        ifs.read(reinterpret_cast<char*>(&population[i].fitness), sizeof(population[i].fitness));
-        if(ifs.fail()){
-             std::cerr << "AVISO: Falha ao ler dados do arquivo de populacao. O arquivo pode estar corrompido. Iniciando do zero." << std::endl;
-             return false;
-        }
+    // Escritas assim, as comparações também rejeitam NaN.
+    if (!(cfg.mutationRate >= 0.0 && cfg.mutationRate <= 1.0) || !(cfg.crossoverRate >= 0.0 && cfg.crossoverRate <= 1.0)) {
+        std::cerr << "--mutation-rate e --crossover-rate devem estar entre 0 e 1." << std::endl;
+        return false;
     }
-    ifs.close();
-    return true;
-}
-
-/**
- * @brief Gera o banco de cenários de teste fixos e os salva em um arquivo.
- * @details Garante que cada cenário gerado tenha um ponto de partida seguro ("safe zone").
- * Esta função só precisa ser executada uma vez se o arquivo não existir.
- */
-void generateFixedGames(const std::string &filename, int totalFixedGames) {
-    std::ofstream ofs(filename, std::ios::binary);
-    if(!ofs) {
-        std::cerr << "Erro ao criar o arquivo de jogos fixos." << std::endl;
-        return;
+    if (cfg.islands.count < 1 || cfg.islands.id < 0 || cfg.islands.id >= cfg.islands.count ||
+        cfg.islands.interval < 1 || cfg.islands.migrants < 0 || cfg.islands.migrants > cfg.populationSize - 2) {
+        std::cerr << "Parametros das ilhas invalidos (islands >= 1, 0 <= island < islands, migration-interval >= 1, "
+                     "0 <= migrants <= population - 2)." << std::endl;
+        return false;
     }
-
-    std::mt19937 gen_fixed(rd_global());
-    std::uniform_int_distribution<> dis_pos(0, GRID_WIDTH - 1);
-
-    for(int i = 0; i < totalFixedGames; i++) {
-        FixedGame fg;
-        fg.startX = dis_pos(gen_fixed);
-        fg.startY = dis_pos(gen_fixed);
-        fg.mineGrid.assign(GRID_HEIGHT, std::vector<bool>(GRID_WIDTH, false));
-
-        int placedMines = 0;
-        while (placedMines < NUM_MINES) {
-            int x = dis_pos(gen_fixed);
-            int y = dis_pos(gen_fixed);
-            bool isInSafeZone = (x >= fg.startX - 1 && x <= fg.startX + 1 && y >= fg.startY - 1 && y <= fg.startY + 1);
-            if (!fg.mineGrid[y][x] && !isInSafeZone) {
-                fg.mineGrid[y][x] = true;
-                placedMines++;
-            }
-        }
-
-        ofs.write(reinterpret_cast<const char*>(&fg.startX), sizeof(fg.startX));
-        ofs.write(reinterpret_cast<const char*>(&fg.startY), sizeof(fg.startY));
-        for(int y = 0; y < GRID_HEIGHT; y++) {
-            for(int x = 0; x < GRID_WIDTH; x++) {
-                char mine = fg.mineGrid[y][x] ? 1 : 0;
-                ofs.write(&mine, sizeof(char));
-            }
-        }
+    if ((!cfg.profileFile.empty() || !cfg.traceFile.empty()) && !profiling::ENABLED) {
+        std::cerr << "--profile e --profile-trace exigem compilar com -DCAMPO_MINADO_PROFILE." << std::endl;
+        return false;
     }
-    ofs.close();
-}
-
-/**
- * @brief Carrega o banco de cenários de teste do arquivo para a memória.
- */
-bool loadFixedGames(std::vector<FixedGame> &fixedGames, const std::string &filename) {
-    std::ifstream ifs(filename, std::ios::binary);
-    if(!ifs) return false;
-
-    fixedGames.clear();
-    while (ifs.peek() != EOF) {
-        FixedGame fg;
-        ifs.read(reinterpret_cast<char*>(&fg.startX), sizeof(fg.startX));
-        ifs.read(reinterpret_cast<char*>(&fg.startY), sizeof(fg.startY));
-        if(ifs.fail()) break;
-
-        fg.mineGrid.assign(GRID_HEIGHT, std::vector<bool>(GRID_WIDTH, false));
-        for(int y = 0; y < GRID_HEIGHT; y++) {
-            for(int x = 0; x < GRID_WIDTH; x++) {
-                char mine;
-                ifs.read(&mine, sizeof(char));
-                fg.mineGrid[y][x] = (mine == 1);
-            }
-        }
-        fixedGames.push_back(fg);
+    if (cfg.traceGenerations < 1) {
+        std::cerr << "--profile-trace-generations deve ser >= 1." << std::endl;
+        return false;
     }
-    ifs.close();
     return true;
 }
 
-/**
- * @brief Seleciona um subconjunto aleatório de cenários de teste do banco global.
- * @details Este subconjunto será usado para avaliar a geração atual.
- * @param numGames O número de jogos a serem selecionados.
- * @return Um vetor de FixedGame.
- */
-std::vector<FixedGame> selectFixedGames(int numGames) {
-    std::vector<FixedGame> selectedGames;
-    if (fixedGamesGlobal.empty()) return selectedGames;
-
-    selectedGames.reserve(numGames);
-    std::sample(fixedGamesGlobal.begin(), fixedGamesGlobal.end(), std::back_inserter(selectedGames),
-                numGames, std::mt19937{std::random_device{}()});
-    return selectedGames;
-}
-
-// === Funções de Visualização ===
-
-/**
- * @brief Calcula o layout de grade para as janelas de visualização.
- */
-void calculateGridLayout(int totalDisplays, int &rows, int &cols) {
-    if (totalDisplays <= 0) {
-        rows = 0;
-        cols = 0;
-        return;
-    }
-    cols = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(totalDisplays))));
-    rows = static_cast<int>(std::ceil(static_cast<double>(totalDisplays) / cols));
-}
-
-/**
- * @brief Cria janelas SDL para visualizar os melhores indivíduos jogando em tempo real.
- * @details Esta função só é ativada se NUM_INDIVIDUALS_TO_DISPLAY for maior que 0.
- */
-void visualizeTopN(const std::vector<Individual> &population, SDL_Window** windows, SDL_Renderer** renderers, TTF_Font* font, int numDisplays) {
-    if (numDisplays <= 0) return;
-
-    std::vector<Individual> sortedPop = population;
-    std::sort(sortedPop.begin(), sortedPop.end(), [](const Individual &a, const Individual &b){
-        return a.fitness > b.fitness;
-    });
-
-    int count = std::min(static_cast<int>(sortedPop.size()), numDisplays);
-    std::vector<Game> games(count);
-    for (int i = 0; i < count; i++) {
-        games[i].initializeGridFixed(sortedPop[i].rules[0].numberCondition, sortedPop[i].rules[0].hiddenCondition, fixedGamesGlobal[i % fixedGamesGlobal.size()].mineGrid);
-    }
-
-    bool stillPlaying = true;
-    while (stillPlaying) {
-        stillPlaying = false;
-        for (int i = 0; i < count; i++) {
-            if (!games[i].gameOver && !games[i].youWin) {
-                bool changed = applyRules(const_cast<Individual&>(sortedPop[i]), games[i]);
-                if (!changed) {
-                    revealRandomCell(games[i]);
-                }
-                stillPlaying = true; // Continua enquanto pelo menos um jogo estiver ativo.
-            }
-        }
-
-        for (int i = 0; i < count; i++) {
-            SDL_SetRenderDrawColor(renderers[i], 50, 50, 50, 255);
-            SDL_RenderClear(renderers[i]);
-            games[i].renderGrid(renderers[i], font, 0, 0);
-            SDL_RenderPresent(renderers[i]);
-        }
-        SDL_Delay(100);
-    }
-}
-
-
 /**
  * @brief Função principal do programa.
  * @details Gerencia o ciclo de vida do algoritmo genético: inicialização, avaliação,
  * seleção, reprodução e salvamento, repetindo por gerações.
+ * Os parâmetros podem ser passados como --chave=valor ou em um arquivo (--config=arquivo).
  */
 int main(int argc, char* argv[]) {
-    std::vector<SDL_Window*> windowsVector;
-    std::vector<SDL_Renderer*> renderersVector;
-    TTF_Font* font = nullptr;
-
-    // 1. Inicialização do SDL (se a visualização estiver ativa)
-    if (NUM_INDIVIDUALS_TO_DISPLAY > 0) {
-        if (SDL_Init(SDL_INIT_VIDEO) != 0) { std::cerr << "Erro SDL: " << SDL_GetError() << std::endl; return 1; }
-        if (TTF_Init() == -1) { std::cerr << "Erro TTF: " << TTF_GetError() << std::endl; SDL_Quit(); return 1; }
-        
-        font = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", 16);
-        if (!font) {
-            std::cerr << "Erro ao carregar a fonte TTF: " << TTF_GetError() << std::endl;
-            TTF_Quit(); SDL_Quit(); return 1;
-        }
-
-        int rows, cols;
-        calculateGridLayout(NUM_INDIVIDUALS_TO_DISPLAY, rows, cols);
-        
-        SDL_DisplayMode DM;
-        SDL_GetCurrentDisplayMode(0, &DM);
-        int screenWidth = DM.w;
-        int screenHeight = DM.h;
-
-        int gridWidth = GRID_WIDTH * CELL_SIZE;
-        int gridHeight = GRID_HEIGHT * CELL_SIZE;
-        int spacing = 50;
-
-        int totalWidth = cols * gridWidth + (cols - 1) * spacing;
-        int totalHeight = rows * gridHeight + (rows - 1) * spacing;
-
-        int startXCenter = (screenWidth - totalWidth) / 2;
-        int startYCenter = (screenHeight - totalHeight) / 2;
-
-        for (int i = 0; i < NUM_INDIVIDUALS_TO_DISPLAY; i++) {
-            int row = i / cols;
-            int col = i % cols;
-            int startX = startXCenter + col * (gridWidth + spacing);
-            int startY = startYCenter + row * (gridHeight + spacing);
-
-            std::string title = "Individuo " + std::to_string(i + 1);
-            SDL_Window* window = SDL_CreateWindow(title.c_str(),
-                                      startX,
-                                      startY,
-                                      gridWidth,
-                                      gridHeight,
-                                      SDL_WINDOW_SHOWN);
-            if (!window) {
-                std::cerr << "Erro na criacao da janela " << i + 1 << ": " << SDL_GetError() << std::endl;
-                return 1;
-            }
-
-            SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-            if (!renderer) {
-                std::cerr << "Erro ao criar renderer da janela " << i + 1 << ": " << SDL_GetError() << std::endl;
-                return 1;
-            }
-
-            windowsVector.push_back(window);
-            renderersVector.push_back(renderer);
-        }
-    }
-
-    // 2. Carrega a população ou cria uma nova se não houver save.
+    Options options;
+    if (!options.parse(argc, argv) || !readTrainingConfig(options, config)) return 1;
+    std::cout << "Semente: " << config.seed << " (use --seed=" << config.seed << " para repetir este treinamento)." << std::endl;
+
+    // Cada ilha tem seus próprios fluxos e seu próprio save; o banco de cenários é o mesmo para todas.
+    const uint64_t masterSeed = config.seed;
+    MigrationChannel migration(config.islands, config.numRules);
+    if (config.islands.enabled()) {
+        config.seed = deriveSeed(masterSeed, {STREAM_ISLAND, static_cast<uint64_t>(config.islands.id)});
+        config.populationFile = migration.checkpointPath(config.populationFile);
+        if (!config.replayFile.empty()) config.replayFile = migration.checkpointPath(config.replayFile);
+        if (!migration.prepare()) return 1;
+        std::cout << "Ilha " << config.islands.id << " de " << config.islands.count << ": save em '" << config.populationFile
+                  << "', migracao a cada " << config.islands.interval << " geracoes por '" << config.islands.directory << "'." << std::endl;
+    }
+
+    // 1. Carrega a população ou cria uma nova se não houver save.
     std::vector<Individual> population;
-    if(!loadPopulation(population, "populacao_regras.dat")) {
+    int savedGeneration = 0; // Última geração concluída do save; 0 sem save.
+    if(!loadCheckpoint(population, config.populationFile, config.checkpointHistory, config.populationSize, config.numRules, savedGeneration)) {
+        savedGeneration = 0;
         std::cout << "Nenhuma populacao salva encontrada. Criando uma nova populacao aleatoria..." << std::endl;
-        population.reserve(POPULATION_SIZE);
-        for (int i = 0; i < POPULATION_SIZE; i++) {
-            population.push_back(createRandomIndividual());
+        population.reserve(config.populationSize);
+        Xoshiro256 initRng(deriveSeed(config.seed, {STREAM_INITIAL_POPULATION}));
+        for (int i = 0; i < config.populationSize; i++) {
+            population.push_back(createRandomIndividual(config.numRules, initRng));
         }
     } else {
-        std::cout << "Populacao carregada de 'populacao_regras.dat'." << std::endl;
+        std::cout << "Populacao carregada de '" << config.populationFile << "' (geracao " << savedGeneration << ")." << std::endl;
     }
 
-    // 3. Gera ou carrega o banco de cenários de teste.
-    std::string fixedGamesFile = "fixed_games.dat";
+    // 2. Gera, converte (formato antigo) ou carrega o banco de cenários de teste.
+    const std::string &fixedGamesFile = config.fixedGamesFile;
     std::ifstream infile(fixedGamesFile, std::ios::binary);
-    if(!infile.good()) {
+    bool bankExists = infile.good();
+    infile.close();
+    if (!bankExists) {
         std::cout << "Arquivo de jogos fixos nao encontrado. Gerando um novo..." << std::endl;
-        generateFixedGames(fixedGamesFile, FIXED_GAME_COUNT);
+        if (!ScenarioBank::generate(fixedGamesFile, config.board, config.fixedGameCount,
+                                     deriveSeed(masterSeed, {STREAM_SCENARIO_BANK}))) return 1;
+    } else if (ScenarioBank::isLegacyFile(fixedGamesFile)) {
+        std::cout << "Convertendo '" << fixedGamesFile << "' para o formato compacto..." << std::endl;
+        if (!ScenarioBank::convertLegacy(fixedGamesFile, config.board)) return 1;
     }
-    infile.close();
-    if(!loadFixedGames(fixedGamesGlobal, fixedGamesFile)) {
+    if (!scenarioBank.open(fixedGamesFile, config.board)) {
         std::cerr << "Erro fatal ao carregar os jogos fixos." << std::endl;
         return 1;
     }
-    std::cout << fixedGamesGlobal.size() << " jogos fixos carregados." << std::endl;
+    std::cout << scenarioBank.size() << " jogos fixos carregados." << std::endl;
+
+    // 3. Visualização (opcional), em uma thread própria que só lê o banco de cenários.
+    Visualizer visualizer(config.board, scenarioBank, config.individualsToDisplay,
+                          deriveSeed(config.seed, {STREAM_VISUALIZATION}));
+    if (config.individualsToDisplay > 0 && !visualizer.start()) return 1;
+
+    // Instrumentação (opcional): um registro por geração e o trace das primeiras gerações.
+    PROFILE_THREAD("treinamento");
+    profiling::ProfileLog profileLog;
+    if (!config.profileFile.empty() && !profileLog.open(config.profileFile)) return 1;
+    bool traceOpen = !config.traceFile.empty();
+    if (traceOpen) profiling::startTrace();
+
+    // Registro de partidas (opcional): as partidas do melhor de cada geração, para rever sem simular.
+    ReplayWriter replayWriter;
+    if (!config.replayFile.empty()) {
+        if (!replayWriter.open(config.replayFile, config.board)) return 1;
+        std::cout << "Gravando as partidas do melhor individuo em '" << config.replayFile << "' a cada "
+                  << config.replayInterval << " geracoes." << std::endl;
+    }
+    Game replayBoard(config.board.width, config.board.height, config.board.numMines);
 
     // 4. Início do Loop de Treinamento (Evolução)
+    // As threads de avaliação são criadas uma única vez e reaproveitadas em todas as gerações.
+    ThreadPool pool(config.numThreads);
+    std::cout << "Avaliando com " << pool.size() << " threads." << std::endl;
+    EvaluationArena arena(pool.size());
+    if (config.gpu) {
+        if (!arena.gpu.init(config.board, config.gpuDevice)) return 1;
+        std::cout << "Avaliando na GPU: " << arena.gpu.deviceName() << "." << std::endl;
+    }
+
+    // A próxima geração é montada em um segundo buffer, trocado com o atual no fim de cada
+    // geração; os vetores de regras dos indivíduos são sobrescritos sem realocação.
+    std::vector<Individual> nextPopulation(config.populationSize);
+    std::vector<int> ranking(population.size());
+    std::vector<Individual> discarded(pool.size()); // Destino do segundo filho, por worker, quando a população já está completa.
+    std::vector<Individual> immigrants; // Migrantes recebidos de outra ilha.
+
+    // Os checkpoints são gravados em segundo plano; o destrutor espera o último terminar.
+    CheckpointWriter checkpoint(config.populationFile, config.checkpointHistory);
+    std::signal(SIGINT, handleInterrupt);
+
     bool running = true;
-    int generation = 1;
+    // Uma execução retomada continua a numeração: os fluxos da geração e os registros não se repetem.
+    int generation = savedGeneration + 1;
     while (running) {
         std::cout << "----------------------------------------" << std::endl;
         std::cout << "Iniciando Geracao: " << generation << std::endl;
 
+        const auto generationStart = std::chrono::steady_clock::now();
+        const profiling::Totals profileStart = profiling::totals();
+
         std::atomic<int> generationWins = 0;
         std::atomic<int> generationGames = 0;
-        std::vector<FixedGame> currentFixedGames = selectFixedGames(GAMES_PER_GENERATION);
-
-        // 4a. Avaliação de Fitness (em paralelo)
-        std::vector<std::future<double>> futures;
-        futures.reserve(POPULATION_SIZE);
-        for (auto &ind : population) {
-            futures.emplace_back(std::async(std::launch::async, [&]() -> double {
-                // É seguro passar os contadores atômicos para a thread.
-                return evaluateIndividual(ind, currentFixedGames, generationWins, generationGames);
-            }));
-        }
-        for (size_t i = 0; i < population.size(); ++i) {
-            population[i].fitness = futures[i].get();
-        }
-
-        // Ordena a população pelo fitness para encontrar o melhor.
-        std::vector<Individual> sortedPop = population;
-        std::sort(sortedPop.begin(), sortedPop.end(), [](const Individual &a, const Individual &b){
-            return a.fitness > b.fitness;
+        // Cada geração tem seus próprios fluxos, derivados da semente mestra e do número da geração.
+        const uint64_t gen = static_cast<uint64_t>(generation);
+        Xoshiro256 selectionRng(deriveSeed(config.seed, {STREAM_SCENARIO_SELECTION, gen}));
+        std::vector<size_t> currentFixedGames = selectFixedGames(config.gamesPerGeneration, selectionRng);
+        buildStartBoards(arena, currentFixedGames);
+
+        // 4a. Avaliação de Fitness (em paralelo, no pool persistente de threads)
+        int gamesPlayed;
+        {
+            PROFILE_SCOPE(EVALUATION);
+            gamesPlayed = evaluatePopulation(pool, population, arena, generationWins, generationGames);
+        }
+
+        // Só o topo do ranking é usado (elites, visualização e migrantes): basta uma ordenação
+        // parcial. O índice desempata, para que clones com o mesmo fitness tenham ordem fixa.
+        const size_t ranked = std::min(population.size(), static_cast<size_t>(std::max(
+            {2, config.individualsToDisplay, config.islands.enabled() ? config.islands.migrants : 0})));
+        ranking.resize(population.size());
+        for (size_t i = 0; i < ranking.size(); i++) ranking[i] = static_cast<int>(i);
+        std::partial_sort(ranking.begin(), ranking.begin() + ranked, ranking.end(), [&](int a, int b) {
+            return population[a].fitness > population[b].fitness || (population[a].fitness == population[b].fitness && a < b);
         });
+        ranking.resize(ranked);
+        const Individual &best = population[ranking[0]];
 
         // Exibe estatísticas da geração.
-        std::cout << "Melhor Fitness da Geracao: " << sortedPop[0].fitness << std::endl;
+        std::cout << "Melhor Fitness da Geracao: " << best.fitness << std::endl;
         if (generationGames > 0) {
             double winRate = (static_cast<double>(generationWins) / generationGames) * 100.0;
             std::cout << "Taxa de Vitoria na Geracao: " << winRate << "% (" << generationWins << "/" << generationGames << ")" << std::endl;
+            std::cout << "Partidas jogadas: " << gamesPlayed << "/" << generationGames
+                      << " (as demais vieram do cache de fitness ou de clones)" << std::endl;
+        }
+
+        if (replayWriter.isOpen() && generation % config.replayInterval == 0) {
+            PROFILE_SCOPE(REPLAY);
+            recordGeneration(replayWriter, best, arena, replayBoard, generation);
         }
 
-        // Visualiza os melhores indivíduos, se ativado.
-        if (NUM_INDIVIDUALS_TO_DISPLAY > 0) {
-            visualizeTopN(sortedPop, windowsVector.data(), renderersVector.data(), font, NUM_INDIVIDUALS_TO_DISPLAY);
+        // Entrega os melhores à visualização, se ativada; o treinamento não espera por ela.
+        if (config.individualsToDisplay > 0) visualizer.publish(population, ranking, generation);
+
+        // Migração: publica os melhores desta ilha e recebe os da ilha anterior no anel.
+        bool migrantsArrived = false;
+        if (config.islands.enabled() && generation % config.islands.interval == 0) {
+            migration.publish(population, ranking, generation);
+            migrantsArrived = migration.receive(immigrants);
+            if (migrantsArrived) std::cout << immigrants.size() << " migrantes recebidos." << std::endl;
         }
 
         // 4b. Criação da Próxima Geração (Seleção, Crossover, Mutação)
-        std::vector<Individual> newPopulation;
-        newPopulation.reserve(POPULATION_SIZE);
-        
+        nextPopulation.resize(config.populationSize);
+        int filled = 0;
+
         // Elitismo: os 2 melhores indivíduos passam diretamente para a próxima geração.
-        newPopulation.push_back(sortedPop[0]);
-        if (sortedPop.size() > 1) newPopulation.push_back(sortedPop[1]);
-        
-        // Preenche o resto da nova população.
-        std::uniform_real_distribution<> dis_prob(0.0, 1.0);
-        while (static_cast<int>(newPopulation.size()) < POPULATION_SIZE) {
-            Individual parent1 = tournamentSelection(population);
-            Individual parent2 = tournamentSelection(population);
-            Individual offspring1, offspring2;
-
-            if (dis_prob(gen_global) < CROSSOVER_RATE) {
-                crossover(parent1, parent2, offspring1, offspring2);
-            } else {
-                offspring1 = parent1;
-                offspring2 = parent2;
+        nextPopulation[filled++] = best;
+        if (ranking.size() > 1 && filled < config.populationSize) nextPopulation[filled++] = population[ranking[1]];
+
+        // Preenche o resto da nova população em paralelo, um par de filhos por tarefa, escrevendo
+        // os filhos direto nas suas posições. Cada par tem o seu próprio fluxo aleatório derivado
+        // do seu índice, então o resultado não depende do número de threads.
+        const int firstChild = filled;
+        const int pairCount = (config.populationSize - firstChild + 1) / 2;
+        pool.parallelFor(pairCount, 0, [&](int worker, int pair) {
+            Xoshiro256 breedingRng(deriveSeed(config.seed, {STREAM_BREEDING, gen, static_cast<uint64_t>(pair)}));
+            std::uniform_real_distribution<> dis_prob(0.0, 1.0);
+            int parentIndex1, parentIndex2;
+            {
+                PROFILE_SCOPE(SELECTION);
+                parentIndex1 = tournamentSelection(population, config.tournamentSize, breedingRng);
+                parentIndex2 = tournamentSelection(population, config.tournamentSize, breedingRng);
+            }
+            const Individual &parent1 = population[parentIndex1];
+            const Individual &parent2 = population[parentIndex2];
+            const int slot = firstChild + 2 * pair;
+            Individual &offspring1 = nextPopulation[slot];
+            Individual &offspring2 = slot + 1 < config.populationSize ? nextPopulation[slot + 1] : discarded[worker];
+
+            {
+                PROFILE_SCOPE(CROSSOVER);
+                if (dis_prob(breedingRng) < config.crossoverRate) {
+                    crossover(parent1, parent2, offspring1, offspring2, breedingRng);
+                } else {
+                    offspring1.genome = parent1.genome;
+                    offspring2.genome = parent2.genome;
+                }
             }
 
-            mutate(offspring1);
-            mutate(offspring2);
+            {
+                PROFILE_SCOPE(MUTATION);
+                mutate(offspring1, config.mutationRate, breedingRng);
+                mutate(offspring2, config.mutationRate, breedingRng);
+            }
+            // O genoma dos filhos está definido: compila o programa de regras uma única vez.
+            {
+                PROFILE_SCOPE(COMPILATION);
+                compileRules(offspring1);
+                compileRules(offspring2);
+            }
+            offspring1.fitness = 0.0; // Ainda não avaliados nesta geração.
+            offspring2.fitness = 0.0;
+        });
 
-            newPopulation.push_back(offspring1);
-            if (static_cast<int>(newPopulation.size()) < POPULATION_SIZE) {
-                newPopulation.push_back(offspring2);
+        // Os migrantes ocupam o lugar dos últimos filhos e são avaliados na próxima geração.
+        if (migrantsArrived) {
+            const size_t slots = std::min(immigrants.size(), static_cast<size_t>(std::max(0, config.populationSize - 2)));
+            for (size_t k = 0; k < slots; k++) {
+                nextPopulation[config.populationSize - 1 - k] = std::move(immigrants[k]);
+                nextPopulation[config.populationSize - 1 - k].fitness = 0.0;
             }
         }
-        
-        population = newPopulation; // A nova geração substitui a antiga.
+
+        std::swap(population, nextPopulation); // A nova geração substitui a antiga.
 
         // 4c. Salvamento e Finalização da Geração
-        if(generation % 5 == 0) { // Salva o progresso a cada 5 gerações.
-            std::cout << "Salvando progresso da populacao..." << std::endl;
-            savePopulation(population, "populacao_regras.dat");
+        if (stopRequested || visualizer.closed()) running = false;
+
+        // Salva o progresso periodicamente e sempre antes de sair.
+        if (generation % config.checkpointInterval == 0 || !running) {
+            std::cout << "Salvando progresso da populacao (em segundo plano)..." << std::endl;
+            checkpoint.submit(population, generation);
         }
 
-        if (NUM_INDIVIDUALS_TO_DISPLAY > 0) {
-            SDL_Event event;
-            while (SDL_PollEvent(&event)) { if (event.type == SDL_QUIT) running = false; }
+        if (profileLog.isOpen()) {
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - generationStart).count();
+            profileLog.write(generation, seconds, gamesPlayed, profiling::totals().since(profileStart));
+        }
+        const int tracedGenerations = generation - savedGeneration; // O trace conta só as gerações desta execução.
+        if (traceOpen && (tracedGenerations == config.traceGenerations || !running)) {
+            profiling::stopTrace();
+            profiling::writeTrace(config.traceFile);
+            std::cout << "Trace das primeiras " << tracedGenerations << " geracoes gravado em '" << config.traceFile << "'." << std::endl;
+            traceOpen = false;
         }
 
         generation++;
     }
 
-    // 5. Limpeza dos recursos do SDL.
-    if (NUM_INDIVIDUALS_TO_DISPLAY > 0) {
-        TTF_CloseFont(font);
-        for (auto& rend : renderersVector) SDL_DestroyRenderer(rend);
-        for (auto& win : windowsVector) SDL_DestroyWindow(win);
-        TTF_Quit();
-        SDL_Quit();
-    }
-
     return 0;
 }
\ No newline at end of file
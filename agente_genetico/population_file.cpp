@@ -0,0 +1,199 @@
+/**
+ * @file population_file.cpp
+ * @brief Leitura e escrita do formato binário da população.
+ */
+
+#include "population_file.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+constexpr char MAGIC[8] = {'C', 'M', 'P', 'O', 'P', 0, 0, 0};
+constexpr uint32_t VERSION = 2;
+constexpr size_t HEADER_BYTES = sizeof(MAGIC) + 4 * sizeof(uint32_t);
+// Geração informada pelos arquivos que não a gravam (formato antigo ou campo zerado).
+constexpr int DEFAULT_GENERATION = 1;
+
+// Bytes de uma Rule no formato antigo (membro a membro, sem o padding da struct).
+constexpr size_t LEGACY_RULE_BYTES = 5 * sizeof(int) + 2 * sizeof(bool) + sizeof(RuleAction);
+
+template <class T>
+void append(std::vector<char> &out, const T &value) {
+    const char *bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * @struct Reader
+ * @brief Cursor sobre o conteúdo do arquivo; `ok` fica falso na primeira leitura além do fim.
+ */
+struct Reader {
+    const char *data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+
+    template <class T>
+    T next() {
+        T value{};
+        if (pos + sizeof(T) > size) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+};
+
+void warnSize(int fileSize, int expectedSize) {
+    std::cerr << "AVISO: O tamanho da populacao no arquivo (" << fileSize << ") e diferente do parametro atual (" << expectedSize << ")." << std::endl;
+}
+
+void warnRules(int fileRules, int numRules) {
+    std::cerr << "AVISO: O numero de regras no arquivo (" << fileRules << ") e diferente do parametro atual (" << numRules << ")." << std::endl;
+}
+
+void warnCorrupted() {
+    std::cerr << "AVISO: Falha ao ler dados do arquivo de populacao. O arquivo pode estar corrompido." << std::endl;
+}
+
+/**
+ * @brief Lê o formato anterior à versão 2: cada membro de cada Rule gravado separadamente.
+ * @details Os indivíduos lidos são convertidos para o genoma compacto; o próximo save já
+ * é gravado no formato atual.
+ */
+bool readLegacy(Reader &in, std::vector<Individual> &population, int expectedSize, int numRules) {
+    const int popSize = in.next<int>();
+    if (!in.ok || popSize < 0 || (expectedSize >= 0 && popSize != expectedSize)) {
+        if (in.ok) warnSize(popSize, expectedSize);
+        return false;
+    }
+
+    population.assign(popSize, Individual());
+    for(int i = 0; i < popSize; i++) {
+        const int fileRules = in.next<int>();
+        if (!in.ok || fileRules != numRules) {
+            if (in.ok) warnRules(fileRules, numRules);
+            return false;
+        }
+        if (in.pos + static_cast<size_t>(numRules) * LEGACY_RULE_BYTES > in.size) {
+            warnCorrupted();
+            return false;
+        }
+        population[i].genome.resize(numRules);
+        for(int j = 0; j < numRules; j++) {
+            Rule rule;
+            rule.numberCondition = in.next<int>();
+            rule.hiddenCondition = in.next<int>();
+            rule.flaggedCondition = in.next<int>();
+            rule.nearEdge = in.next<bool>();
+            rule.hasSpecificPattern = in.next<bool>();
+            rule.extendedScope = in.next<int>();
+            rule.priority = in.next<int>();
+            rule.action = in.next<RuleAction>();
+            population[i].genome[j] = packRule(rule);
+        }
+        population[i].fitness = in.next<double>();
+        if (!in.ok) {
+            warnCorrupted();
+            return false;
+        }
+        compileRules(population[i]);
+    }
+    return true;
+}
+
+} // namespace
+
+void serializePopulation(const std::vector<Individual> &population, int generation, std::vector<char> &out) {
+    const uint32_t numRules = population.empty() ? 0 : static_cast<uint32_t>(population[0].genome.size());
+    out.clear();
+    out.reserve(HEADER_BYTES + population.size() * (numRules * sizeof(uint32_t) + sizeof(double)));
+
+    out.insert(out.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    append(out, VERSION);
+    append(out, static_cast<uint32_t>(population.size()));
+    append(out, numRules);
+    append(out, static_cast<uint32_t>(std::max(generation, 0)));
+
+    // Os genomas, em sequência, formam um único bloco de palavras; depois vêm os fitness.
+    for (const auto &ind : population) {
+        const char *words = reinterpret_cast<const char*>(ind.genome.data());
+        out.insert(out.end(), words, words + numRules * sizeof(uint32_t));
+    }
+    for (const auto &ind : population) append(out, ind.fitness);
+}
+
+bool writePopulation(std::ostream &os, const std::vector<Individual> &population, int generation) {
+    std::vector<char> buffer;
+    serializePopulation(population, generation, buffer);
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return !os.fail();
+}
+
+bool readPopulation(std::istream &is, std::vector<Individual> &population, int expectedSize, int numRules,
+                    int *generation) {
+    const std::vector<char> contents((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    Reader in{contents.data(), contents.size()};
+    if (contents.size() < sizeof(MAGIC) || std::memcmp(contents.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        if (generation) *generation = DEFAULT_GENERATION;
+        return readLegacy(in, population, expectedSize, numRules);
+    }
+
+    in.pos = sizeof(MAGIC);
+    const uint32_t version = in.next<uint32_t>();
+    const int popSize = static_cast<int>(in.next<uint32_t>());
+    const int fileRules = static_cast<int>(in.next<uint32_t>());
+    const uint32_t fileGeneration = in.next<uint32_t>();
+    if (!in.ok) {
+        warnCorrupted();
+        return false;
+    }
+    if (version != VERSION) {
+        std::cerr << "AVISO: O arquivo de populacao esta na versao " << version << "; este programa le a versao " << VERSION << "." << std::endl;
+        return false;
+    }
+    if (popSize < 0 || (expectedSize >= 0 && popSize != expectedSize)) {
+        warnSize(popSize, expectedSize);
+        return false;
+    }
+    if (popSize > 0 && fileRules != numRules) {
+        warnRules(fileRules, numRules);
+        return false;
+    }
+    const size_t genomeBytes = static_cast<size_t>(numRules) * sizeof(uint32_t);
+    if (contents.size() != HEADER_BYTES + static_cast<size_t>(popSize) * (genomeBytes + sizeof(double))) {
+        warnCorrupted();
+        return false;
+    }
+
+    population.assign(popSize, Individual());
+    const char *genomes = contents.data() + HEADER_BYTES;
+    const char *fitness = genomes + popSize * genomeBytes;
+    for (int i = 0; i < popSize; i++) {
+        population[i].genome.resize(numRules);
+        std::memcpy(population[i].genome.data(), genomes + i * genomeBytes, genomeBytes);
+        std::memcpy(&population[i].fitness, fitness + i * sizeof(double), sizeof(double));
+        compileRules(population[i]);
+    }
+    if (generation) {
+        *generation = fileGeneration == 0 || fileGeneration > static_cast<uint32_t>(INT_MAX)
+                          ? DEFAULT_GENERATION : static_cast<int>(fileGeneration);
+    }
+    return true;
+}
+
+bool loadPopulation(std::vector<Individual> &population, const std::string &filename, int expectedSize, int numRules,
+                    int *generation) {
+    std::ifstream ifs(filename, std::ios::binary);
+    if(!ifs) return false;
+    return readPopulation(ifs, population, expectedSize, numRules, generation);
+}
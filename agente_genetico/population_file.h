@@ -0,0 +1,59 @@
+/**
+ * @file population_file.h
+ * @brief Formato binário da população do agente genético (save e arquivos de migrantes).
+ * @details Formato (versão 2): assinatura "CMPOP\0\0\0", versão, número de indivíduos,
+ * regras por indivíduo e a geração que produziu a população (uint32 cada; 0 nos arquivos
+ * gravados antes de o campo existir); depois os genomas de todos os
+ * indivíduos em um único bloco de palavras de 32 bits (o genoma compacto, ver GeneField) e
+ * o fitness (double) de cada um, todos na representação nativa da máquina. Arquivos no
+ * formato anterior (cada membro de cada Rule gravado separadamente) continuam sendo lidos e
+ * são regravados no formato atual no próximo save. O mesmo formato é usado pelo save da população
+ * (populacao_regras.dat, gravado por checkpoint.h) e pelos arquivos de migrantes do modelo
+ * de ilhas (island.h).
+ */
+
+#ifndef CAMPO_MINADO_POPULATION_FILE_H
+#define CAMPO_MINADO_POPULATION_FILE_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "rules.h"
+
+/**
+ * @brief Serializa os indivíduos em um único buffer contíguo, no formato do arquivo.
+ * @param generation Última geração concluída, gravada no cabeçalho.
+ * @param out Substituído pelo conteúdo do arquivo (a capacidade é reaproveitada).
+ */
+void serializePopulation(const std::vector<Individual> &population, int generation, std::vector<char> &out);
+
+/**
+ * @brief Escreve os indivíduos em `os`.
+ * @param generation Última geração concluída, gravada no cabeçalho.
+ * @return false se a escrita falhar.
+ */
+bool writePopulation(std::ostream &os, const std::vector<Individual> &population, int generation);
+
+/**
+ * @brief Lê indivíduos de `is` e compila suas regras.
+ * @param expectedSize Número de indivíduos exigido (negativo aceita qualquer número).
+ * @param numRules Número de regras exigido em cada indivíduo.
+ * @param generation Se não for nulo, recebe a geração gravada no cabeçalho (1 nos arquivos
+ * sem o campo: toda população salva vem de ao menos uma geração).
+ * @return false se o conteúdo não corresponder aos parâmetros ou estiver truncado (a
+ * mensagem de aviso já foi impressa).
+ */
+bool readPopulation(std::istream &is, std::vector<Individual> &population, int expectedSize, int numRules,
+                    int *generation = nullptr);
+
+/**
+ * @brief Carrega uma população previamente salva de um arquivo binário.
+ * @param generation Como em readPopulation.
+ * @return true se o carregamento for bem-sucedido, false caso contrário.
+ */
+bool loadPopulation(std::vector<Individual> &population, const std::string &filename, int expectedSize, int numRules,
+                    int *generation = nullptr);
+
+#endif // CAMPO_MINADO_POPULATION_FILE_H
@@ -0,0 +1,200 @@
+/**
+ * @file rules.cpp
+ * @brief Compilação e execução dos programas de regras do agente genético.
+ */
+
+#include "rules.h"
+
+#include <algorithm>
+
+#include "../comum/board_shape.h"
+#include "../comum/profiler.h"
+
+namespace {
+
+/**
+ * @brief Verdadeiro se as condições da regra permitem que sua ação chegue a disparar.
+ * @details Revelar exige bandeiras == número e ao menos um oculto; marcar exige exatamente
+ * um oculto e bandeiras == número - 1. O "padrão específico" só existe em casas com 2.
+ */
+bool canFire(const Rule &rule) {
+    if (rule.numberCondition < 0 || rule.numberCondition > 8) return false;
+    if (rule.extendedScope != 1 && rule.extendedScope != 2) return false;
+    if (rule.hasSpecificPattern && rule.numberCondition != 2) return false;
+
+    int windowCells = (2 * rule.extendedScope + 1) * (2 * rule.extendedScope + 1) - 1;
+    if (rule.hiddenCondition < 0 || rule.flaggedCondition < 0) return false;
+    if (rule.hiddenCondition + rule.flaggedCondition > windowCells) return false;
+
+    if (rule.action == ACTION_REVEAL_HIDDEN) {
+        return rule.flaggedCondition == rule.numberCondition && rule.hiddenCondition > 0;
+    }
+    return rule.hiddenCondition == 1 && rule.flaggedCondition == rule.numberCondition - 1;
+}
+
+bool sameCompiledRule(const CompiledRule &a, const CompiledRule &b) {
+    return a.hiddenCondition == b.hiddenCondition && a.flaggedCondition == b.flaggedCondition &&
+           a.scope == b.scope && a.nearEdge == b.nearEdge && a.action == b.action;
+}
+
+uint64_t hashProgram(const RuleProgram &program) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&](uint64_t byte) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+    for (uint16_t start : program.bucketStart) {
+        mix(start & 0xFF);
+        mix(start >> 8);
+    }
+    for (const CompiledRule &rule : program.rules) {
+        mix(rule.hiddenCondition);
+        mix(rule.flaggedCondition);
+        mix(rule.scope);
+        mix(rule.nearEdge);
+        mix(static_cast<uint64_t>(rule.action));
+    }
+    return hash;
+}
+
+template <class Shape>
+bool applyRules(const Shape &shape, const RuleProgram &program, Game &game) {
+    bool changed = false;
+    uint64_t tests = 0; // Contado localmente: PROFILE_COUNT só no fim da passada.
+    uint64_t firings = 0;
+    for (int y = 0; y < shape.height; y++) {
+        for (int x = 0; x < shape.width; x++) {
+            int idx = shape.index(x, y);
+            if (game.state(idx) != REVEALED) continue;
+            int number = game.neighboringMines(idx);
+            int begin = program.bucketStart[number];
+            int end = program.bucketStart[number + 1];
+
+            // O resumo é relido a cada regra: uma regra que disparou já o atualizou.
+            for (int r = begin; r < end; r++) {
+                const CompiledRule &rule = program.rules[r];
+                const CellFeatures &f = game.features[idx];
+                if (rule.nearEdge && !f.nearEdge()) continue;
+                tests++;
+                int hidden = rule.scope == 1 ? f.hidden1 : f.hidden2;
+                int flagged = rule.scope == 1 ? f.flagged1 : f.flagged2;
+                if (hidden != rule.hiddenCondition || flagged != rule.flaggedCondition) continue;
+
+                uint32_t targets = f.hiddenMask & (rule.scope == 1 ? CellFeatures::RADIUS1_MASK : CellFeatures::RADIUS2_MASK);
+                if (rule.action == ACTION_REVEAL_HIDDEN) {
+                    // Cópia da máscara: o flood fill pode revelar alvos seguintes, que são ignorados.
+                    while (targets != 0 && !game.gameOver && !game.youWin) {
+                        int k = __builtin_ctz(targets);
+                        targets &= targets - 1;
+                        game.revealIndex(idx + game.windowOffsets[k]);
+                    }
+                } else {
+                    game.placeFlagIndex(idx + game.windowOffsets[__builtin_ctz(targets)]);
+                }
+                changed = true;
+                firings++;
+                if (game.gameOver || game.youWin) {
+                    PROFILE_COUNT(RULE_TESTS, tests);
+                    PROFILE_COUNT(RULE_FIRINGS, firings);
+                    return changed;
+                }
+            }
+        }
+    }
+    PROFILE_COUNT(RULE_TESTS, tests);
+    PROFILE_COUNT(RULE_FIRINGS, firings);
+    return changed;
+}
+
+} // namespace
+
+uint32_t packRule(const Rule &rule) {
+    uint32_t gene = 0;
+    gene = withGeneField(gene, GENE_NUMBER, rule.numberCondition);
+    gene = withGeneField(gene, GENE_HIDDEN, rule.hiddenCondition);
+    gene = withGeneField(gene, GENE_FLAGGED, rule.flaggedCondition);
+    gene = withGeneField(gene, GENE_NEAR_EDGE, rule.nearEdge);
+    gene = withGeneField(gene, GENE_PATTERN, rule.hasSpecificPattern);
+    gene = withGeneField(gene, GENE_SCOPE, rule.extendedScope);
+    gene = withGeneField(gene, GENE_PRIORITY, rule.priority);
+    gene = withGeneField(gene, GENE_ACTION, rule.action == ACTION_PLACE_FLAG);
+    return gene;
+}
+
+Rule unpackRule(uint32_t gene) {
+    Rule rule;
+    rule.numberCondition = geneField(gene, GENE_NUMBER);
+    rule.hiddenCondition = geneField(gene, GENE_HIDDEN);
+    rule.flaggedCondition = geneField(gene, GENE_FLAGGED);
+    rule.nearEdge = geneField(gene, GENE_NEAR_EDGE) != 0;
+    rule.hasSpecificPattern = geneField(gene, GENE_PATTERN) != 0;
+    rule.extendedScope = geneField(gene, GENE_SCOPE);
+    rule.priority = geneField(gene, GENE_PRIORITY);
+    rule.action = geneField(gene, GENE_ACTION) ? ACTION_PLACE_FLAG : ACTION_REVEAL_HIDDEN;
+    return rule;
+}
+
+void compileRules(Individual &ind) {
+    // Ordena por prioridade (maior primeiro) preservando a ordem original nos empates.
+    std::vector<Rule> ordered;
+    ordered.reserve(ind.genome.size());
+    for (uint32_t gene : ind.genome) ordered.push_back(unpackRule(gene));
+    std::stable_sort(ordered.begin(), ordered.end(), [](const Rule &a, const Rule &b) {
+        return a.priority > b.priority;
+    });
+
+    std::vector<CompiledRule> buckets[9];
+    RuleProgram program;
+    for (const Rule &rule : ordered) {
+        if (!canFire(rule)) continue;
+        CompiledRule compiled;
+        compiled.hiddenCondition = static_cast<uint8_t>(rule.hiddenCondition);
+        compiled.flaggedCondition = static_cast<uint8_t>(rule.flaggedCondition);
+        compiled.scope = static_cast<uint8_t>(rule.extendedScope);
+        compiled.nearEdge = rule.nearEdge ? 1 : 0;
+        compiled.action = rule.action;
+
+        auto &bucket = buckets[rule.numberCondition];
+        bool duplicate = std::any_of(bucket.begin(), bucket.end(), [&](const CompiledRule &other) {
+            return sameCompiledRule(other, compiled);
+        });
+        if (duplicate) continue;
+        bucket.push_back(compiled);
+        program.scopeMask[rule.numberCondition] |= static_cast<uint8_t>(1 << (compiled.scope - 1));
+    }
+
+    for (int n = 0; n < 9; n++) {
+        program.bucketStart[n] = static_cast<uint16_t>(program.rules.size());
+        program.rules.insert(program.rules.end(), buckets[n].begin(), buckets[n].end());
+    }
+    program.bucketStart[9] = static_cast<uint16_t>(program.rules.size());
+    program.hash = hashProgram(program);
+    ind.program = std::move(program);
+}
+
+bool sameProgram(const RuleProgram &a, const RuleProgram &b) {
+    if (a.hash != b.hash || a.rules.size() != b.rules.size()) return false;
+    if (!std::equal(std::begin(a.bucketStart), std::end(a.bucketStart), std::begin(b.bucketStart))) return false;
+    return std::equal(a.rules.begin(), a.rules.end(), b.rules.begin(), sameCompiledRule);
+}
+
+bool applyRules(const Individual &ind, Game &game) {
+    if (ind.program.empty() || game.gameOver || game.youWin) return false;
+    return withBoardShape(game, [&](const auto &shape) { return applyRules(shape, ind.program, game); });
+}
+
+void revealRandomCell(Game &game, Xoshiro256 &rng) {
+    if (game.hiddenCount <= 0) return;
+    PROFILE_COUNT(RANDOM_MOVES, 1);
+    // Xoshiro256::below, e não uma distribuição de <random>: o backend de GPU repete o sorteio.
+    int pick = static_cast<int>(rng.below(game.hiddenCount));
+    for (int y = 0; y < game.height; y++) {
+        for (int x = 0; x < game.width; x++) {
+            int idx = game.index(x, y);
+            if (game.state(idx) == HIDDEN && pick-- == 0) {
+                game.revealIndex(idx);
+                return;
+            }
+        }
+    }
+}
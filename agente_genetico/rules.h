@@ -0,0 +1,152 @@
+/**
+ * @file rules.h
+ * @brief Genoma do agente genético (regras e indivíduos) e o programa de regras compilado.
+ * @details As regras de um indivíduo são o seu "DNA" e só mudam na reprodução. No genoma,
+ * cada regra ocupa uma única palavra de 32 bits (um campo por nibble, ver GeneField), então
+ * crossover, mutação e distância genética trabalham direto sobre palavras. Para jogar,
+ * elas são compiladas uma única vez em um RuleProgram imutável: regras que nunca podem
+ * disparar são descartadas, duplicatas são removidas e as restantes são agrupadas pelo
+ * número da casa (numberCondition) em ordem de prioridade. Assim, cada casa revelada é
+ * comparada apenas com as regras que podem disparar sobre ela.
+ */
+
+#ifndef CAMPO_MINADO_RULES_H
+#define CAMPO_MINADO_RULES_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../comum/game.h"
+#include "../comum/rng.h"
+
+/**
+ * @enum RuleAction
+ * @brief Define as duas possíveis ações que uma regra pode executar.
+ */
+enum RuleAction {
+    ACTION_REVEAL_HIDDEN,
+    ACTION_PLACE_FLAG
+};
+
+/**
+ * @struct Rule
+ * @brief Representa um único "gene" ou "instinto" de uma IA.
+ * @details Contém um conjunto de condições e uma ação a ser tomada se todas as condições forem satisfeitas.
+ * É a forma decodificada de uma palavra do genoma (ver packRule e unpackRule).
+ */
+struct Rule {
+    int numberCondition;      // Condição: número na casa revelada.
+    int hiddenCondition;      // Condição: número de vizinhos ocultos.
+    int flaggedCondition;     // Condição: número de vizinhos com bandeira.
+    bool nearEdge;            // Condição: a casa está perto da borda?
+    bool hasSpecificPattern;  // Condição: um padrão específico foi detectado? (Placeholder)
+    int extendedScope;        // Condição: qual o tamanho da vizinhança a ser analisada?
+    int priority;             // Prioridade da regra (regras de maior prioridade são testadas primeiro).
+    RuleAction action;        // Ação a ser executada.
+};
+
+/**
+ * @enum GeneField
+ * @brief Campos de uma regra no genoma compacto, na ordem da struct Rule.
+ * @details Cada regra do genoma é uma palavra de 32 bits com um campo por nibble: o campo f
+ * ocupa os bits 4f a 4f + 3. Os valores são os mesmos de Rule (ações: 0 revelar, 1 marcar).
+ */
+enum GeneField {
+    GENE_NUMBER,      // numberCondition (0 a 8)
+    GENE_HIDDEN,      // hiddenCondition (0 a 8)
+    GENE_FLAGGED,     // flaggedCondition (0 a 8)
+    GENE_NEAR_EDGE,   // nearEdge (0 ou 1)
+    GENE_PATTERN,     // hasSpecificPattern (0 ou 1)
+    GENE_SCOPE,       // extendedScope (1 ou 2)
+    GENE_PRIORITY,    // priority (1 a 10)
+    GENE_ACTION,      // action (0 ou 1)
+    GENE_FIELDS
+};
+
+/** @brief Valor do campo `field` da regra compacta `gene`. */
+inline int geneField(uint32_t gene, int field) { return static_cast<int>((gene >> (4 * field)) & 0xF); }
+
+/** @brief A regra `gene` com o campo `field` trocado por `value` (só os 4 bits baixos contam). */
+inline uint32_t withGeneField(uint32_t gene, int field, int value) {
+    const int shift = 4 * field;
+    return (gene & ~(0xFu << shift)) | ((static_cast<uint32_t>(value) & 0xF) << shift);
+}
+
+/** @brief Codifica uma regra em uma palavra do genoma. */
+uint32_t packRule(const Rule &rule);
+
+/** @brief Decodifica uma palavra do genoma. */
+Rule unpackRule(uint32_t gene);
+
+/**
+ * @struct CompiledRule
+ * @brief Forma compacta de uma regra dentro de um RuleProgram.
+ * @details numberCondition e hasSpecificPattern não aparecem aqui: o primeiro é implícito no
+ * grupo em que a regra está, e o segundo é resolvido na compilação.
+ */
+struct CompiledRule {
+    uint8_t hiddenCondition;  // Vizinhos ocultos exigidos no escopo.
+    uint8_t flaggedCondition; // Vizinhos com bandeira exigidos no escopo.
+    uint8_t scope;            // Raio da vizinhança (1 = 3x3, 2 = 5x5).
+    uint8_t nearEdge;         // 1 se a casa precisa estar perto da borda.
+    RuleAction action;        // Ação a ser executada.
+};
+
+/**
+ * @struct RuleProgram
+ * @brief Conjunto imutável de regras pronto para jogar, agrupado pelo número da casa.
+ */
+struct RuleProgram {
+    std::vector<CompiledRule> rules; // Regras agrupadas pelo número, em ordem de prioridade.
+    uint16_t bucketStart[10] = {};   // Regras do número n: [bucketStart[n], bucketStart[n + 1]).
+    uint8_t scopeMask[9] = {};       // Bit 0: o grupo n usa escopo 1; bit 1: usa escopo 2.
+    uint64_t hash = 0;               // Hash (FNV-1a) das regras e dos grupos, calculado por compileRules.
+
+    bool empty() const { return rules.empty(); }
+};
+
+/**
+ * @brief Verdadeiro se os dois programas têm exatamente as mesmas regras nos mesmos grupos.
+ * @details Dois programas iguais jogam de forma idêntica, mesmo que venham de genomas
+ * diferentes (regras descartadas ou duplicadas não entram no programa).
+ */
+bool sameProgram(const RuleProgram &a, const RuleProgram &b);
+
+/**
+ * @struct Individual
+ * @brief Representa uma única IA na população.
+ */
+struct Individual {
+    std::vector<uint32_t> genome; // O "cérebro" ou "DNA" do indivíduo: uma regra compacta (packRule) por palavra.
+    double fitness = 0.0;         // Pontuação que mede o quão bem o indivíduo joga.
+    RuleProgram program;          // Regras compiladas; recompile (compileRules) sempre que `genome` mudar.
+};
+
+/**
+ * @brief Compila as regras de um indivíduo em seu RuleProgram.
+ * @details Deve ser chamada depois de criar, carregar, cruzar ou mutar um indivíduo.
+ * Descarta regras cujas condições nunca permitem que a ação dispare (ex: revelar exige
+ * bandeiras == número e ao menos um vizinho oculto) e duplicatas exatas de regras de
+ * prioridade maior. A ordem entre regras de mesma prioridade é a ordem original.
+ */
+void compileRules(Individual &ind);
+
+/**
+ * @brief Aplica o programa de regras de um indivíduo ao tabuleiro.
+ * @details Percorre as casas reveladas uma vez; para cada uma, testa em ordem de prioridade
+ * apenas as regras do grupo do seu número e executa todas as que dispararem. As condições
+ * são comparadas com o resumo de vizinhança da casa (Game::features), sem varrer a janela.
+ * @return true se alguma regra foi aplicada e uma ação foi tomada, false caso contrário.
+ */
+bool applyRules(const Individual &ind, Game &game);
+
+/**
+ * @brief Revela uma célula oculta aleatória. Usado como fallback quando a IA fica presa.
+ * @details O sorteio usa o contador de células ocultas do tabuleiro e depois procura a
+ * k-ésima célula oculta em ordem de linha, sem montar uma lista das candidatas.
+ * @param game O tabuleiro.
+ * @param rng Gerador do fluxo da partida (cada partida tem o seu).
+ */
+void revealRandomCell(Game &game, Xoshiro256 &rng);
+
+#endif // CAMPO_MINADO_RULES_H
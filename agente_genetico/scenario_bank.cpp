@@ -0,0 +1,247 @@
+/**
+ * @file scenario_bank.cpp
+ * @brief Implementação do banco de cenários mapeado em memória.
+ */
+
+#include "scenario_bank.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../comum/rng.h"
+
+namespace {
+
+const char BANK_MAGIC[8] = {'C', 'M', 'B', 'A', 'N', 'K', 0, 0};
+
+size_t maskBytes(const BoardConfig &board) { return (static_cast<size_t>(board.width) * board.height + 7) / 8; }
+
+uint64_t fnv1a(uint64_t hash, const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+
+/**
+ * @brief Grava um banco completo em `path`, pedindo cada registro a `fill`.
+ * @details `fill(i, record)` recebe o registro já zerado. O cabeçalho é reescrito no final
+ * com o checksum, e o arquivo temporário só substitui `path` depois de fechado com sucesso.
+ */
+bool writeBank(const std::string &path, const BoardConfig &board, uint64_t count,
+               const std::function<bool(uint64_t, uint8_t *)> &fill) {
+    if (board.width > 0xFFFF || board.height > 0xFFFF) {
+        std::cerr << "Tabuleiro grande demais para o banco de cenarios." << std::endl;
+        return false;
+    }
+    // O pid no nome temporário permite que várias ilhas gerem o mesmo banco ao mesmo tempo.
+    const std::string tmpPath = path + ".tmp." + std::to_string(::getpid());
+    std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+        std::cerr << "Erro ao criar o arquivo de jogos fixos " << tmpPath << "." << std::endl;
+        return false;
+    }
+
+    ScenarioBankHeader header = {};
+    std::memcpy(header.magic, BANK_MAGIC, sizeof(header.magic));
+    header.version = ScenarioBank::VERSION;
+    header.headerSize = sizeof(ScenarioBankHeader);
+    header.width = static_cast<uint16_t>(board.width);
+    header.height = static_cast<uint16_t>(board.height);
+    header.numMines = static_cast<uint32_t>(board.numMines);
+    header.count = count;
+    header.recordSize = static_cast<uint32_t>(4 + maskBytes(board));
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<uint8_t> record(header.recordSize);
+    uint64_t checksum = FNV_OFFSET;
+    for (uint64_t i = 0; i < count; i++) {
+        std::fill(record.begin(), record.end(), 0);
+        if (!fill(i, record.data())) {
+            ofs.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+        checksum = fnv1a(checksum, record.data(), record.size());
+        ofs.write(reinterpret_cast<const char*>(record.data()), record.size());
+    }
+    header.checksum = checksum;
+    ofs.seekp(0);
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.close();
+    if (ofs.fail() || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Erro ao gravar o arquivo de jogos fixos " << path << "." << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void writeStart(uint8_t *record, int startX, int startY) {
+    record[0] = static_cast<uint8_t>(startX & 0xFF);
+    record[1] = static_cast<uint8_t>(startX >> 8);
+    record[2] = static_cast<uint8_t>(startY & 0xFF);
+    record[3] = static_cast<uint8_t>(startY >> 8);
+}
+
+} // namespace
+
+ScenarioBank::~ScenarioBank() { close(); }
+
+bool ScenarioBank::generate(const std::string &path, const BoardConfig &board, uint64_t count, uint64_t seed) {
+    // Mesmo gerador dos demais fluxos do treinamento: os 64 bits da semente contam.
+    Xoshiro256 rng(seed);
+    const uint64_t width = static_cast<uint64_t>(board.width);
+    const uint64_t height = static_cast<uint64_t>(board.height);
+
+    return writeBank(path, board, count, [&](uint64_t, uint8_t *record) {
+        int startX = static_cast<int>(rng.below(width));
+        int startY = static_cast<int>(rng.below(height));
+        writeStart(record, startX, startY);
+        uint8_t *mines = record + 4;
+
+        // Garante que cada cenário gerado tenha um ponto de partida seguro ("safe zone").
+        int placedMines = 0;
+        while (placedMines < board.numMines) {
+            int x = static_cast<int>(rng.below(width));
+            int y = static_cast<int>(rng.below(height));
+            bool isInSafeZone = (x >= startX - 1 && x <= startX + 1 && y >= startY - 1 && y <= startY + 1);
+            int bit = y * board.width + x;
+            if (!(mines[bit >> 3] & (1 << (bit & 7))) && !isInSafeZone) {
+                mines[bit >> 3] |= static_cast<uint8_t>(1 << (bit & 7));
+                placedMines++;
+            }
+        }
+        return true;
+    });
+}
+
+bool ScenarioBank::isLegacyFile(const std::string &path) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) return false;
+    char magic[sizeof(BANK_MAGIC)] = {};
+    ifs.read(magic, sizeof(magic));
+    return std::memcmp(magic, BANK_MAGIC, sizeof(magic)) != 0;
+}
+
+bool ScenarioBank::convertLegacy(const std::string &path, const BoardConfig &board) {
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs) return false;
+
+    const std::streamoff cells = static_cast<std::streamoff>(board.width) * board.height;
+    const std::streamoff recordSize = 2 * sizeof(int) + cells;
+    const std::streamoff size = ifs.tellg();
+    if (size % recordSize != 0) {
+        std::cerr << "O arquivo " << path << " nao corresponde a um tabuleiro " << board.width << "x" << board.height
+                  << ". Apague-o ou use --fixed-games-file para gerar outro banco." << std::endl;
+        return false;
+    }
+    ifs.seekg(0);
+
+    // O arquivo antigo é lido inteiro antes de ser substituído pelo novo.
+    std::vector<char> legacy(static_cast<size_t>(size));
+    ifs.read(legacy.data(), size);
+    ifs.close();
+
+    return writeBank(path, board, static_cast<uint64_t>(size / recordSize), [&](uint64_t i, uint8_t *record) {
+        const char *src = legacy.data() + i * recordSize;
+        int startX, startY;
+        std::memcpy(&startX, src, sizeof(int));
+        std::memcpy(&startY, src + sizeof(int), sizeof(int));
+        if (startX < 0 || startX >= board.width || startY < 0 || startY >= board.height) {
+            std::cerr << "O arquivo " << path << " tem um ponto de partida fora do tabuleiro (" << startX << ", " << startY
+                      << ") no cenario " << i << ". Apague-o ou use --fixed-games-file para gerar outro banco." << std::endl;
+            return false;
+        }
+        writeStart(record, startX, startY);
+        int mines = 0;
+        for (std::streamoff c = 0; c < cells; c++) {
+            if (src[2 * sizeof(int) + c] != 1) continue;
+            record[4 + (c >> 3)] |= static_cast<uint8_t>(1 << (c & 7));
+            mines++;
+        }
+        if (mines != board.numMines) {
+            std::cerr << "O arquivo " << path << " foi gerado com " << mines << " minas, mas a configuracao atual usa "
+                      << board.numMines << ". Apague-o ou use --fixed-games-file para gerar outro banco." << std::endl;
+            return false;
+        }
+        return true;
+    });
+}
+
+bool ScenarioBank::open(const std::string &path, const BoardConfig &board) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ScenarioBankHeader)) {
+        ::close(fd);
+        std::cerr << "O arquivo " << path << " nao e um banco de cenarios valido." << std::endl;
+        return false;
+    }
+    void *addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // O mapeamento continua válido depois de fechar o descritor.
+    if (addr == MAP_FAILED) {
+        std::cerr << "Erro ao mapear o arquivo " << path << " em memoria." << std::endl;
+        return false;
+    }
+    mapping = addr;
+    mappingSize = static_cast<size_t>(st.st_size);
+
+    ScenarioBankHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    if (std::memcmp(header.magic, BANK_MAGIC, sizeof(header.magic)) != 0 || header.version != VERSION ||
+        header.headerSize != sizeof(ScenarioBankHeader)) {
+        std::cerr << "O arquivo " << path << " nao e um banco de cenarios na versao " << VERSION << "." << std::endl;
+        close();
+        return false;
+    }
+    if (header.width != board.width || header.height != board.height || header.numMines != static_cast<uint32_t>(board.numMines)) {
+        std::cerr << "O arquivo " << path << " foi gerado para um tabuleiro " << header.width << "x" << header.height
+                  << " com " << header.numMines << " minas, mas a configuracao atual usa " << board.width << "x"
+                  << board.height << " com " << board.numMines << " minas. Apague-o ou use --fixed-games-file para gerar outro banco." << std::endl;
+        close();
+        return false;
+    }
+    if (header.recordSize != 4 + maskBytes(board) ||
+        mappingSize != header.headerSize + header.count * header.recordSize) {
+        std::cerr << "O arquivo " << path << " esta truncado ou corrompido." << std::endl;
+        close();
+        return false;
+    }
+
+    const uint8_t *data = static_cast<const uint8_t*>(mapping) + header.headerSize;
+    if (fnv1a(FNV_OFFSET, data, header.count * header.recordSize) != header.checksum) {
+        std::cerr << "Checksum invalido no arquivo " << path << ". Apague-o para gerar outro banco." << std::endl;
+        close();
+        return false;
+    }
+    // A avaliação sorteia cenários espalhados pelo arquivo; leitura antecipada não ajuda.
+    madvise(mapping, mappingSize, MADV_RANDOM);
+
+    records = data;
+    count = static_cast<size_t>(header.count);
+    recordSize = header.recordSize;
+    return true;
+}
+
+void ScenarioBank::close() {
+    if (mapping) munmap(mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+    records = nullptr;
+    count = 0;
+    recordSize = 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file scenario_bank.h
+ * @brief Banco de cenários de teste do agente genético, em um arquivo binário mapeado em memória.
+ * @details Formato (versão 1, little-endian):
+ * - cabeçalho (ScenarioBankHeader): assinatura, versão, dimensões, minas, número de cenários,
+ *   tamanho de cada registro e checksum (FNV-1a de 64 bits) de todos os registros;
+ * - registros de tamanho fixo: startX e startY (uint16) seguidos da máscara de minas com um
+ *   bit por célula, em ordem de linha (bit i = célula y * largura + x).
+ *
+ * Um tabuleiro 10x10 ocupa 17 bytes por cenário (eram 108 no formato antigo, com um char por
+ * célula). O arquivo é aberto com mmap e os cenários são lidos diretamente do mapeamento pelo
+ * índice, sem cópia nem alocação por cenário; a memória é o próprio cache de páginas do
+ * sistema. Um banco de 10^6 cenários 10x10 ocupa 17 MB, e validar o checksum ao abri-lo
+ * custa uma única leitura sequencial do arquivo.
+ */
+
+#ifndef CAMPO_MINADO_SCENARIO_BANK_H
+#define CAMPO_MINADO_SCENARIO_BANK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../comum/config.h"
+
+/**
+ * @struct ScenarioBankHeader
+ * @brief Cabeçalho do arquivo do banco de cenários.
+ */
+struct ScenarioBankHeader {
+    char magic[8];        // "CMBANK\0\0".
+    uint32_t version;     // Versão do formato (ScenarioBank::VERSION).
+    uint32_t headerSize;  // sizeof(ScenarioBankHeader); os registros começam neste offset.
+    uint16_t width;       // Dimensões do tabuleiro.
+    uint16_t height;
+    uint32_t numMines;    // Minas de cada cenário.
+    uint64_t count;       // Número de cenários.
+    uint32_t recordSize;  // Bytes por cenário: 4 + ceil(width * height / 8).
+    uint32_t reserved;
+    uint64_t checksum;    // FNV-1a de 64 bits de todos os registros.
+};
+
+/**
+ * @struct Scenario
+ * @brief Visão de um cenário dentro do banco (aponta para o mapeamento, não copia nada).
+ */
+struct Scenario {
+    int startX;               // Ponto de partida seguro.
+    int startY;
+    const uint8_t *mineBits;  // Máscara de minas (bit y * largura + x).
+};
+
+/**
+ * @class ScenarioBank
+ * @brief Banco de cenários aberto somente para leitura via mmap.
+ */
+class ScenarioBank {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    ScenarioBank() = default;
+    ~ScenarioBank();
+    ScenarioBank(const ScenarioBank &) = delete;
+    ScenarioBank &operator=(const ScenarioBank &) = delete;
+
+    /**
+     * @brief Gera um banco novo com `count` cenários e o grava em `path`.
+     * @details Cada cenário tem as minas fora da área 3x3 ao redor do ponto de partida. O
+     * arquivo é escrito em um temporário (`path.tmp.<pid>`) e renomeado no final, então nunca fica pela metade.
+     * @return false em caso de erro de escrita (a mensagem já foi impressa).
+     */
+    static bool generate(const std::string &path, const BoardConfig &board, uint64_t count, uint64_t seed);
+
+    /** @brief Verdadeiro se `path` existe e não começa com a assinatura do formato atual. */
+    static bool isLegacyFile(const std::string &path);
+
+    /**
+     * @brief Converte um banco no formato antigo (int startX, int startY e um char por célula)
+     * para o formato atual, no mesmo caminho.
+     * @return false se o arquivo não corresponder ao tabuleiro informado ou não puder ser reescrito.
+     */
+    static bool convertLegacy(const std::string &path, const BoardConfig &board);
+
+    /**
+     * @brief Mapeia o banco em memória e valida o cabeçalho e o checksum.
+     * @details Recusa bancos gerados para outro tamanho de tabuleiro ou número de minas.
+     * @return false se o arquivo for inválido (a mensagem de erro já foi impressa).
+     */
+    bool open(const std::string &path, const BoardConfig &board);
+
+    /** @brief Desfaz o mapeamento (chamado também pelo destrutor). */
+    void close();
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /** @brief Cenário de índice `i` (0 <= i < size()), lido diretamente do mapeamento. */
+    Scenario scenario(size_t i) const {
+        const uint8_t *record = records + i * recordSize;
+        return {record[0] | (record[1] << 8), record[2] | (record[3] << 8), record + 4};
+    }
+
+private:
+    void *mapping = nullptr;
+    size_t mappingSize = 0;
+    const uint8_t *records = nullptr;
+    size_t count = 0;
+    size_t recordSize = 0;
+};
+
+#endif // CAMPO_MINADO_SCENARIO_BANK_H
@@ -0,0 +1,237 @@
+/**
+ * @file visualizer.cpp
+ * @brief Implementação da visualização em thread própria.
+ */
+
+#include "visualizer.h"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../comum/board_renderer.h"
+#include "../comum/profiler.h"
+
+namespace {
+
+const int CELL_SIZE = Visualizer::CELL_SIZE;
+
+/**
+ * @struct Display
+ * @brief Janelas, renderers e fonte da visualização (só a thread de visualização os usa).
+ */
+struct Display {
+    std::vector<SDL_Window*> windows;
+    std::vector<SDL_Renderer*> renderers;
+    std::vector<std::unique_ptr<BoardRenderer>> boards; // Um por renderer.
+    TTF_Font* font = nullptr;
+};
+
+/** @brief Visual das janelas do treinamento: casas menores e mensagem colorida, sem faixa. */
+BoardTheme trainingTheme() {
+    BoardTheme theme;
+    theme.cellSize = CELL_SIZE;
+    theme.hidden = {100, 100, 100, 255};
+    const SDL_Color digits[8] = {{0, 0, 255, 255}, {0, 255, 0, 255}, {255, 0, 0, 255}, {0, 0, 128, 255},
+                                 {128, 0, 0, 255}, {0, 128, 128, 255}, {0, 0, 0, 255}, {128, 128, 128, 255}};
+    std::copy(std::begin(digits), std::end(digits), theme.digits);
+    theme.loseMessage = "Game Over!";
+    theme.winMessage = "You Win!";
+    theme.loseText = {255, 0, 0, 255};
+    theme.winText = {0, 255, 0, 255};
+    theme.loseBand = {0, 0, 0, 0};
+    theme.winBand = {0, 0, 0, 0};
+    return theme;
+}
+
+/**
+ * @brief Calcula o layout de grade para as janelas de visualização.
+ */
+void calculateGridLayout(int totalDisplays, int &rows, int &cols) {
+    if (totalDisplays <= 0) {
+        rows = 0;
+        cols = 0;
+        return;
+    }
+    cols = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(totalDisplays))));
+    rows = static_cast<int>(std::ceil(static_cast<double>(totalDisplays) / cols));
+}
+
+/**
+ * @brief Inicializa o SDL e cria uma janela por indivíduo exibido, em grade no centro da tela.
+ * @return false em caso de erro (a mensagem já foi escrita em std::cerr).
+ */
+bool openDisplay(Display &display, const BoardConfig &board, int numDisplays) {
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) { std::cerr << "Erro SDL: " << SDL_GetError() << std::endl; return false; }
+    if (TTF_Init() == -1) { std::cerr << "Erro TTF: " << TTF_GetError() << std::endl; SDL_Quit(); return false; }
+
+    display.font = TTF_OpenFont("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", 16);
+    if (!display.font) {
+        std::cerr << "Erro ao carregar a fonte TTF: " << TTF_GetError() << std::endl;
+        TTF_Quit(); SDL_Quit(); return false;
+    }
+
+    int rows, cols;
+    calculateGridLayout(numDisplays, rows, cols);
+
+    SDL_DisplayMode DM;
+    SDL_GetCurrentDisplayMode(0, &DM);
+    int screenWidth = DM.w;
+    int screenHeight = DM.h;
+
+    int gridWidth = board.width * CELL_SIZE;
+    int gridHeight = board.height * CELL_SIZE;
+    int spacing = 50;
+
+    int totalWidth = cols * gridWidth + (cols - 1) * spacing;
+    int totalHeight = rows * gridHeight + (rows - 1) * spacing;
+
+    int startXCenter = (screenWidth - totalWidth) / 2;
+    int startYCenter = (screenHeight - totalHeight) / 2;
+
+    for (int i = 0; i < numDisplays; i++) {
+        int row = i / cols;
+        int col = i % cols;
+        int startX = startXCenter + col * (gridWidth + spacing);
+        int startY = startYCenter + row * (gridHeight + spacing);
+
+        std::string title = "Individuo " + std::to_string(i + 1);
+        SDL_Window* window = SDL_CreateWindow(title.c_str(),
+                                  startX,
+                                  startY,
+                                  gridWidth,
+                                  gridHeight,
+                                  SDL_WINDOW_SHOWN);
+        if (!window) {
+            std::cerr << "Erro na criacao da janela " << i + 1 << ": " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+        if (!renderer) {
+            std::cerr << "Erro ao criar renderer da janela " << i + 1 << ": " << SDL_GetError() << std::endl;
+            SDL_DestroyWindow(window);
+            return false;
+        }
+
+        display.windows.push_back(window);
+        display.renderers.push_back(renderer);
+        display.boards.push_back(std::make_unique<BoardRenderer>(renderer, display.font, trainingTheme()));
+    }
+    return true;
+}
+
+/** @brief Libera tudo o que openDisplay criou (também depois de uma falha parcial). */
+void closeDisplay(Display &display) {
+    if (!display.font) return; // SDL e TTF já foram encerrados por openDisplay.
+    display.boards.clear(); // As texturas pertencem aos renderers: liberadas antes deles.
+    TTF_CloseFont(display.font);
+    for (auto& rend : display.renderers) SDL_DestroyRenderer(rend);
+    for (auto& win : display.windows) SDL_DestroyWindow(win);
+    display = Display{};
+    TTF_Quit();
+    SDL_Quit();
+}
+
+} // namespace
+
+Visualizer::Visualizer(const BoardConfig &board, const ScenarioBank &bank, int numDisplays, uint64_t seed)
+    : board(board), bank(bank), numDisplays(numDisplays), seed(seed) {}
+
+Visualizer::~Visualizer() { stop(); }
+
+bool Visualizer::start() {
+    std::promise<bool> ready;
+    std::future<bool> started = ready.get_future();
+    thread = std::thread(&Visualizer::run, this, std::move(ready));
+    if (started.get()) return true;
+    thread.join(); // A thread já terminou depois de relatar a falha.
+    return false;
+}
+
+void Visualizer::publish(const std::vector<Individual> &population, const std::vector<int> &ranking, int generation) {
+    PROFILE_SCOPE(VISUALIZATION);
+    VisualSnapshot &snapshot = channel.writeBuffer();
+    const size_t count = std::min(ranking.size(), static_cast<size_t>(numDisplays));
+    snapshot.generation = generation;
+    snapshot.best.resize(count);
+    for (size_t i = 0; i < count; i++) snapshot.best[i] = population[ranking[i]];
+    channel.publish();
+}
+
+void Visualizer::stop() {
+    stopping.store(true, std::memory_order_relaxed);
+    if (thread.joinable()) thread.join();
+}
+
+void Visualizer::run(std::promise<bool> ready) {
+    PROFILE_THREAD("visualizacao");
+    Display display;
+    if (!openDisplay(display, board, numDisplays)) {
+        closeDisplay(display);
+        ready.set_value(false);
+        return;
+    }
+    ready.set_value(true);
+
+    std::vector<Game> games;
+    Xoshiro256 rng;
+    bool playing = false;
+    bool redraw = true;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        const Uint32 frameStart = SDL_GetTicks();
+
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) windowClosed.store(true, std::memory_order_relaxed);
+            redraw = true;
+        }
+
+        // Só troca de geração depois que as partidas em exibição terminam.
+        if (!playing && channel.consume()) {
+            const VisualSnapshot &snapshot = channel.readBuffer();
+            rng.seed(deriveSeed(seed, {static_cast<uint64_t>(snapshot.generation)}));
+            games.assign(snapshot.best.size(), Game(board.width, board.height, board.numMines));
+            for (size_t i = 0; i < games.size(); i++) {
+                const Scenario scenario = bank.scenario(i % bank.size());
+                games[i].initializeGridFixed(scenario.startX, scenario.startY, scenario.mineBits);
+            }
+            playing = true;
+            redraw = true;
+        } else if (playing) {
+            PROFILE_SCOPE(VISUALIZATION);
+            const VisualSnapshot &snapshot = channel.readBuffer();
+            playing = false;
+            for (size_t i = 0; i < games.size(); i++) {
+                if (!games[i].gameOver && !games[i].youWin) {
+                    bool changed = applyRules(snapshot.best[i], games[i]);
+                    if (!changed) {
+                        revealRandomCell(games[i], rng);
+                    }
+                    playing = true; // Continua enquanto pelo menos um jogo estiver ativo.
+                }
+            }
+            redraw = true;
+        }
+
+        if (redraw) {
+            PROFILE_SCOPE(VISUALIZATION); // Só o desenho; a espera pelo próximo quadro fica de fora.
+            for (size_t i = 0; i < games.size(); i++) {
+                SDL_SetRenderDrawColor(display.renderers[i], 50, 50, 50, 255);
+                SDL_RenderClear(display.renderers[i]);
+                display.boards[i]->draw(games[i]);
+                SDL_RenderPresent(display.renderers[i]);
+            }
+            redraw = false;
+        }
+
+        const Uint32 elapsed = SDL_GetTicks() - frameStart;
+        if (elapsed < static_cast<Uint32>(FRAME_MS)) SDL_Delay(FRAME_MS - elapsed);
+    }
+    closeDisplay(display);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file visualizer.h
+ * @brief Visualização dos melhores indivíduos jogando, em uma thread própria.
+ * @details O treinamento nunca espera pela renderização: ao fim de cada geração, a thread
+ * principal copia os melhores indivíduos para um SnapshotChannel e segue para a próxima
+ * geração. A thread de visualização cria as janelas, trata os eventos do SDL e reproduz as
+ * partidas no seu próprio ritmo (um passo a cada FRAME_MS). Quando todas as partidas em
+ * exibição terminam, ela pega o snapshot mais recente; as gerações que passaram nesse
+ * intervalo simplesmente não são exibidas.
+ *
+ * Todas as chamadas ao SDL são feitas pela thread de visualização. Isso funciona no Linux
+ * (X11/Wayland); no macOS o SDL exige que janelas e eventos fiquem na thread principal.
+ */
+
+#ifndef CAMPO_MINADO_VISUALIZER_H
+#define CAMPO_MINADO_VISUALIZER_H
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "../comum/config.h"
+#include "../comum/snapshot_channel.h"
+#include "rules.h"
+#include "scenario_bank.h"
+
+/**
+ * @struct VisualSnapshot
+ * @brief Melhores indivíduos de uma geração, enviados à thread de visualização.
+ */
+struct VisualSnapshot {
+    int generation = 0;
+    std::vector<Individual> best; // Do melhor para o pior.
+};
+
+/**
+ * @class Visualizer
+ * @brief Janelas SDL que mostram os melhores indivíduos jogando, atualizadas por snapshots.
+ */
+class Visualizer {
+public:
+    static const int CELL_SIZE = 20;
+    static const int FRAME_MS = 100; // Intervalo entre dois passos das partidas exibidas.
+
+    /**
+     * @param board Tabuleiro das partidas.
+     * @param bank Banco de cenários (só leitura; precisa continuar aberto enquanto a visualização rodar).
+     * @param numDisplays Número de janelas (uma por indivíduo exibido).
+     * @param seed Semente do fluxo de visualização; cada geração exibida deriva a sua.
+     */
+    Visualizer(const BoardConfig &board, const ScenarioBank &bank, int numDisplays, uint64_t seed);
+
+    /** @brief Encerra a thread, se estiver rodando, e libera os recursos do SDL. */
+    ~Visualizer();
+
+    Visualizer(const Visualizer &) = delete;
+    Visualizer &operator=(const Visualizer &) = delete;
+
+    /**
+     * @brief Cria a thread de visualização e espera a inicialização do SDL e das janelas.
+     * @return false se o SDL, a fonte ou alguma janela não puderem ser criados.
+     */
+    bool start();
+
+    /**
+     * @brief Envia os `numDisplays` melhores indivíduos da geração, sem esperar pela thread de visualização.
+     * @param ranking Índices dos melhores da população (ao menos os usados aqui), em ordem decrescente de fitness.
+     */
+    void publish(const std::vector<Individual> &population, const std::vector<int> &ranking, int generation);
+
+    /** @brief Verdadeiro depois que o usuário fechou as janelas. */
+    bool closed() const { return windowClosed.load(std::memory_order_relaxed); }
+
+    /** @brief Pede o fim da thread de visualização e espera por ela. */
+    void stop();
+
+private:
+    void run(std::promise<bool> ready);
+
+    BoardConfig board;
+    const ScenarioBank &bank;
+    int numDisplays;
+    uint64_t seed;
+
+    SnapshotChannel<VisualSnapshot> channel;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> windowClosed{false};
+    std::thread thread;
+};
+
+#endif // CAMPO_MINADO_VISUALIZER_H
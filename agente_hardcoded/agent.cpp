@@ -0,0 +1,158 @@
+/**
+ * @file agent.cpp
+ * @brief Implementação da lógica de decisão do agente hardcoded.
+ */
+
+#include "agent.h"
+
+#include <chrono>
+#include <vector>
+
+#include "../comum/board_shape.h"
+
+void revealRandomHidden(Game& game, std::mt19937& gen) {
+    std::vector<int> hidden_cells;
+    for (int y = 0; y < game.height; ++y) for (int x = 0; x < game.width; ++x) {
+        int idx = game.index(x, y);
+        if (game.state(idx) == HIDDEN) hidden_cells.push_back(idx);
+    }
+    if (!hidden_cells.empty()) {
+        int pick = std::uniform_int_distribution<>(0, hidden_cells.size() - 1)(gen);
+        game.revealIndex(hidden_cells[pick]);
+    }
+}
+
+// ==========================================================
+//               LÓGICA DO AGENTE HARDCODED
+// ==========================================================
+
+namespace {
+
+/**
+ * @brief Regras 1 e 2 sobre uma geometria de tabuleiro (fixa em tempo de compilação nos tamanhos comuns).
+ */
+template <class Shape>
+bool applyBasicRules(const Shape& shape, Game& game) {
+    for (int y = 0; y < shape.height; ++y) {
+        for (int x = 0; x < shape.width; ++x) {
+            int idx = shape.index(x, y);
+            if (game.state(idx) != REVEALED || game.neighboringMines(idx) == 0) continue;
+
+            int hiddenNeighbors = 0;
+            int flaggedNeighbors = 0;
+            int hiddenCells[8];
+
+            // A borda de sentinelas dispensa a checagem de limites nos vizinhos.
+            for (int offset : game.neighborOffsets) {
+                int n = idx + offset;
+                if (game.state(n) == HIDDEN) {
+                    hiddenCells[hiddenNeighbors++] = n;
+                } else if (game.state(n) == FLAGGED) {
+                    flaggedNeighbors++;
+                }
+            }
+
+            if (hiddenNeighbors > 0) {
+                // Regra 1: Se flags == numero, revela os outros vizinhos ocultos.
+                if (game.neighboringMines(idx) == flaggedNeighbors) {
+                    for (int i = 0; i < hiddenNeighbors; ++i) game.revealIndex(hiddenCells[i]);
+                    return true;
+                }
+                // Regra 2: Se casas ocultas == (numero - flags), marca os vizinhos ocultos.
+                if ((game.neighboringMines(idx) - flaggedNeighbors) == hiddenNeighbors) {
+                    for (int i = 0; i < hiddenNeighbors; ++i) game.placeFlag(game.cellX(hiddenCells[i]), game.cellY(hiddenCells[i]));
+                    return true;
+                }
+            }
+        }
+    }
+    return false; // Nenhuma regra básica pôde ser aplicada.
+}
+
+} // namespace
+
+bool applyBasicRules(Game& game) {
+    return withBoardShape(game, [&](const auto& shape) { return applyBasicRules(shape, game); });
+}
+
+
+// --- REGRA 3: Resolvedor de Restrições da Fronteira ---
+
+namespace {
+
+/** @brief Preenche o chute do relatório com a casa de menor probabilidade de `solution`. */
+MoveResult guessFrom(const Game& game, const AgentContext& context, const FrontierSolution& solution, StepReport& report) {
+    int best_idx = context.guesser.chooseGuess(game, solution, report.guessProbability);
+    if (best_idx < 0) return MoveResult::FAILED;
+    report.guessCell = {game.cellX(best_idx), game.cellY(best_idx)};
+    return MoveResult::NO_GUARANTEED_MOVE;
+}
+
+} // namespace
+
+MoveResult solveByConstraints(Game& game, AgentContext& context, std::mt19937& gen, StepReport& report) {
+    FrontierSolution solution;
+    report.backend = context.guesser.estimate(game, context.solver, gen, solution);
+    if (report.backend == GuessBackend::RANDOM) return MoveResult::FAILED;
+    report.components = solution.components;
+    report.componentsEnumerated = solution.componentsEnumerated;
+    if (report.backend != GuessBackend::EXACT) return guessFrom(game, context, solution, report);
+
+    // 1. Todas as jogadas garantidas da fronteira de uma vez: a análise continua válida
+    // depois de cada uma, já que só confirma o que ela mesma provou.
+    int moves = 0;
+    for (size_t i = 0; i < solution.frontier.size() && !game.gameOver && !game.youWin; ++i) {
+        int idx = solution.frontier[i];
+        if (solution.mineProbability[i] == 1.0) {
+            game.placeFlagIndex(idx);
+            moves++;
+        } else if (solution.mineProbability[i] == 0.0 && game.state(idx) == HIDDEN) {
+            game.revealIndex(idx); // Pode já ter sido aberta pela cascata de outra casa livre.
+            moves++;
+        }
+    }
+    // 2. O interior também pode estar decidido (ex: todas as minas restantes já estão na fronteira).
+    if (!solution.interior.empty() && (solution.interiorProbability == 0.0 || solution.interiorProbability == 1.0)) {
+        for (size_t i = 0; i < solution.interior.size() && !game.gameOver && !game.youWin; ++i) {
+            int idx = solution.interior[i];
+            if (game.state(idx) != HIDDEN) continue;
+            if (solution.interiorProbability == 0.0) game.revealIndex(idx);
+            else game.placeFlagIndex(idx);
+            moves++;
+        }
+    }
+    if (moves > 0) {
+        report.guaranteedMoves = moves;
+        return MoveResult::GUARANTEED_MOVE_FOUND;
+    }
+
+    // 3. Se não há jogadas seguras, escolhe o melhor chute (menor probabilidade de ser mina).
+    return guessFrom(game, context, solution, report);
+}
+
+bool agentStep(Game& game, std::mt19937& gen, AgentContext& context, StepReport& report) {
+    report = StepReport();
+
+    // 1. Tenta aplicar as regras básicas e determinísticas.
+    if (applyBasicRules(game)) {
+        report.actionTaken = report.basicRule = true;
+        return true;
+    }
+
+    // 2. Se as regras básicas falharem, aciona o resolvedor de restrições da fronteira
+    // (e, se ele estourar o orçamento, as estimativas aproximadas).
+    auto start = std::chrono::steady_clock::now();
+    report.result = solveByConstraints(game, context, gen, report);
+    report.solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.solverCalled = true;
+
+    // 3. Impasse: chute probabilístico ou, se a análise falhou, totalmente aleatório.
+    if (report.result == MoveResult::NO_GUARANTEED_MOVE) {
+        game.revealCell(report.guessCell.first, report.guessCell.second);
+    } else if (report.result == MoveResult::FAILED) {
+        if (game.hiddenCount == 0) return false;
+        revealRandomHidden(game, gen);
+    }
+    report.actionTaken = true;
+    return true;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file agent.h
+ * @brief Lógica de decisão do agente hardcoded, independente da interface gráfica.
+ * @details A mesma jogada é usada pelo laço com janela SDL (main.cpp) e pelo modo de
+ * benchmark sem interface (benchmark.h). O agente não imprime nada: o que aconteceu em
+ * cada passo é devolvido em um StepReport, e quem chama decide se registra ou não.
+ */
+
+#ifndef CAMPO_MINADO_AGENT_H
+#define CAMPO_MINADO_AGENT_H
+
+#include <random>
+#include <utility>
+
+#include "../comum/game.h"
+#include "guess.h"
+#include "solver.h"
+
+// Alias para um par de inteiros, usado para representar coordenadas (x, y).
+using CellCoord = std::pair<int, int>;
+
+/**
+ * @enum MoveResult
+ * @brief Descreve o resultado da análise de restrições da fronteira.
+ */
+enum class MoveResult {
+    GUARANTEED_MOVE_FOUND, // Jogadas 100% seguras (minas ou casas livres) foram encontradas e executadas.
+    NO_GUARANTEED_MOVE,    // Nenhuma jogada segura foi encontrada, mas foi calculado um chute probabilístico.
+    FAILED                 // Nenhum backend de probabilidade deu certo (ex: tabuleiro inconsistente).
+};
+
+/**
+ * @struct AgentContext
+ * @brief Estado do agente que persiste entre as jogadas (um por partida em andamento ou por thread).
+ */
+struct AgentContext {
+    FrontierSolver solver;
+    GuessEngine guesser;
+};
+
+/**
+ * @struct StepReport
+ * @brief O que o agente fez em um passo (agentStep).
+ */
+struct StepReport {
+    bool actionTaken = false;         // Alguma jogada foi feita.
+    bool basicRule = false;           // A jogada veio das regras básicas (Regras 1 e 2).
+    bool solverCalled = false;        // O resolvedor de restrições foi chamado.
+    MoveResult result = MoveResult::FAILED; // Resultado do resolvedor (válido se solverCalled).
+    double solveSeconds = 0.0;        // Duração da chamada a solveByConstraints.
+    GuessBackend backend = GuessBackend::EXACT; // Origem das probabilidades (válido se solverCalled).
+    CellCoord guessCell = {-1, -1};   // Casa chutada (se result == NO_GUARANTEED_MOVE).
+    double guessProbability = 1.0;    // P(mina) da casa chutada.
+    int guaranteedMoves = 0;          // Jogadas garantidas executadas (se result == GUARANTEED_MOVE_FOUND).
+    int components = 0;               // Componentes da fronteira na chamada ao resolvedor.
+    int componentsEnumerated = 0;     // Desses, quantos foram enumerados (os demais vieram do cache).
+};
+
+/**
+ * @brief Revela uma célula oculta aleatória. Usado como último recurso pela IA em um impasse total.
+ * @param game O estado atual do jogo.
+ * @param gen Gerador usado no sorteio.
+ */
+void revealRandomHidden(Game& game, std::mt19937& gen);
+
+/**
+ * @brief Aplica as regras lógicas básicas e determinísticas do Campo Minado.
+ * @details Regra 1: Se o número de bandeiras ao redor de uma casa é igual ao número da casa, revela as vizinhas ocultas.
+ * Regra 2: Se o número de casas ocultas é igual ao (número da casa - bandeiras), marca as ocultas como minas.
+ * @param game O estado atual do jogo.
+ * @return true se uma ação foi tomada, false caso contrário.
+ */
+bool applyBasicRules(Game& game);
+
+/**
+ * @brief Tenta resolver o jogo com as probabilidades de mina das casas ocultas (guess.h).
+ * @details Esta é a Regra 3 da IA. O backend exato calcula a probabilidade exata de cada casa
+ * oculta ser uma mina, combinando os componentes independentes da fronteira com o número de
+ * formas de distribuir as minas restantes no interior. Toda casa com probabilidade 0 ou 1 é
+ * uma jogada garantida, e todas as de uma mesma análise são executadas de uma vez (param se
+ * a partida terminar). Se não houver nenhuma, ou se o backend exato estourar o orçamento e
+ * a estimativa vier do Monte Carlo ou da densidade, escolhe a casa de menor probabilidade
+ * para um "chute inteligente".
+ * @param game O estado atual do jogo.
+ * @param context Resolvedor e motor de chutes da partida, que reaproveitam o trabalho das chamadas anteriores.
+ * @param gen Gerador usado pelo backend Monte Carlo.
+ * @param report Recebe o backend usado, o chute (casa e probabilidade), o número de jogadas
+ * garantidas executadas e as contagens de componentes.
+ * @return Um enum MoveResult indicando o resultado da análise.
+ */
+MoveResult solveByConstraints(Game& game, AgentContext& context, std::mt19937& gen, StepReport& report);
+
+/**
+ * @brief Executa uma jogada completa do agente: regras básicas, resolvedor e, em último caso, chute.
+ * @param game O estado atual do jogo (não deve ter terminado).
+ * @param gen Gerador do Monte Carlo e do chute aleatório quando nenhuma estimativa dá certo.
+ * @param context Estado do agente (um por thread; pode ser reaproveitado entre partidas).
+ * @param report Saída com o que foi feito neste passo.
+ * @return true se alguma jogada foi feita (igual a report.actionTaken).
+ */
+bool agentStep(Game& game, std::mt19937& gen, AgentContext& context, StepReport& report);
+
+#endif // CAMPO_MINADO_AGENT_H
@@ -0,0 +1,125 @@
+/**
+ * @file agent_thread.cpp
+ * @brief Implementação da thread do agente hardcoded.
+ */
+
+#include "agent_thread.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+/** @brief Imprime o "raciocínio" do agente a partir do relatório do passo. */
+void printReport(const StepReport &report) {
+    if (!report.solverCalled) return;
+    std::cout << "Regras basicas nao encontraram jogada. Analisando a fronteira..." << std::endl;
+    if (report.result == MoveResult::GUARANTEED_MOVE_FOUND) {
+        std::cout << "Analise encontrou " << report.guaranteedMoves << " jogada(s) 100% segura(s)!" << std::endl;
+    } else {
+        std::cout << "IMPASSE: Nenhuma jogada 100% segura foi encontrada." << std::endl;
+        if (report.result == MoveResult::NO_GUARANTEED_MOVE) {
+            std::cout << "Chutando a celula com menor probabilidade de ser uma bomba (estimativa: "
+                      << guessBackendName(report.backend) << ")..." << std::endl;
+            std::cout << "Melhor chute: (" << report.guessCell.first << ", " << report.guessCell.second
+                      << ") com P(Mina) = " << std::fixed << std::setprecision(2) << report.guessProbability * 100 << "%" << std::endl;
+        } else {
+            std::cout << "Analise complexa falhou. Chutando uma celula aleatoria..." << std::endl;
+        }
+    }
+}
+
+} // namespace
+
+AgentThread::AgentThread(const BoardConfig &board, const GuessConfig &guess, int stepMs, std::function<void()> notify)
+    : game(board.width, board.height, board.numMines), gen(std::random_device{}()), stepMs(stepMs), notify(std::move(notify)) {
+    context.guesser.config = guess;
+}
+
+AgentThread::~AgentThread() { stop(); }
+
+void AgentThread::start() { thread = std::thread(&AgentThread::run, this); }
+
+void AgentThread::restart() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        restartRequested = true;
+    }
+    wake.notify_one();
+}
+
+void AgentThread::setTurbo(bool on) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        turboMode.store(on, std::memory_order_relaxed);
+    }
+    wake.notify_one(); // Encerra a pausa em andamento.
+}
+
+void AgentThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (thread.joinable()) thread.join();
+}
+
+void AgentThread::startNewGame() {
+    game.initializeGrid();
+    int startX = std::uniform_int_distribution<>(0, game.width - 1)(gen);
+    int startY = std::uniform_int_distribution<>(0, game.height - 1)(gen);
+    game.startGameAt(startX, startY, gen);
+    std::cout << "\n--- NOVO JOGO INICIADO EM (" << startX << "," << startY << ") ---" << std::endl;
+}
+
+void AgentThread::publish(bool stuck) {
+    AgentFrame &frame = channel.writeBuffer();
+    frame.game = game; // Os buffers do quadro mantêm a capacidade: a cópia não aloca depois da primeira.
+    frame.stuck = stuck;
+    channel.publish();
+    notify();
+}
+
+void AgentThread::run() {
+    startNewGame();
+    publish(false);
+    bool autoPlay = true;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (restartRequested) {
+            restartRequested = false;
+            lock.unlock();
+            startNewGame();
+            autoPlay = true;
+            publish(false);
+            lock.lock();
+            continue;
+        }
+
+        // Partida encerrada ou agente preso: espera por uma nova partida, sem gastar CPU.
+        if (!autoPlay || game.gameOver || game.youWin) {
+            wake.wait(lock, [&] { return stopping || restartRequested; });
+            continue;
+        }
+
+        lock.unlock();
+        StepReport report;
+        bool actionTaken = agentStep(game, gen, context, report);
+        printReport(report);
+
+        // Se nenhuma ação foi possível, o agente está preso e para de jogar.
+        if (!actionTaken && !game.gameOver && !game.youWin) {
+            std::cout << "AGENTE PRESO: Nenhuma acao possivel. Reinicie (R) ou feche." << std::endl;
+            autoPlay = false;
+        }
+        publish(!autoPlay);
+        lock.lock();
+
+        if (!turbo()) {
+            wake.wait_for(lock, std::chrono::milliseconds(stepMs), [&] { return stopping || restartRequested || turbo(); });
+        }
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file agent_thread.h
+ * @brief Partida do agente hardcoded em uma thread própria, separada da janela.
+ * @details A thread do agente é dona do tabuleiro: ela joga, imprime o "raciocínio" de cada
+ * passo e, depois de cada jogada, publica uma cópia do tabuleiro em um SnapshotChannel e
+ * chama `notify`. A janela só desenha quando recebe um tabuleiro novo (o BoardRenderer
+ * redesenha só as casas que mudaram), então uma análise demorada da fronteira nunca trava a
+ * interface, e a janela não gasta CPU enquanto nada muda.
+ *
+ * No ritmo normal há uma pausa de `stepMs` entre duas jogadas; no modo turbo o agente joga
+ * sem pausa. Como o canal só guarda o último tabuleiro, a janela pula os intermediários
+ * quando o agente joga mais rápido do que ela desenha.
+ */
+
+#ifndef CAMPO_MINADO_AGENT_THREAD_H
+#define CAMPO_MINADO_AGENT_THREAD_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "../comum/config.h"
+#include "../comum/game.h"
+#include "../comum/snapshot_channel.h"
+#include "agent.h"
+#include "guess.h"
+
+/**
+ * @struct AgentFrame
+ * @brief Tabuleiro publicado pela thread do agente depois de uma jogada.
+ */
+struct AgentFrame {
+    Game game = Game(0, 0, 0); // Substituído pela cópia do tabuleiro a cada publicação.
+    bool stuck = false;        // O agente não encontrou nenhuma jogada e parou.
+};
+
+/**
+ * @class AgentThread
+ * @brief Thread que joga as partidas do agente e publica o tabuleiro para a janela.
+ */
+class AgentThread {
+public:
+    /**
+     * @param board Tabuleiro das partidas.
+     * @param guess Backends e orçamentos dos chutes.
+     * @param stepMs Pausa entre duas jogadas fora do modo turbo.
+     * @param notify Chamada pela thread do agente depois de cada publicação (ex: para acordar
+     * o laço de eventos); precisa ser segura para chamar de outra thread.
+     */
+    AgentThread(const BoardConfig &board, const GuessConfig &guess, int stepMs, std::function<void()> notify);
+
+    /** @brief Encerra a thread, se estiver rodando. */
+    ~AgentThread();
+
+    AgentThread(const AgentThread &) = delete;
+    AgentThread &operator=(const AgentThread &) = delete;
+
+    /** @brief Começa a primeira partida na thread do agente. */
+    void start();
+
+    /** @brief Pede uma nova partida; a atual é abandonada depois da jogada em andamento. */
+    void restart();
+
+    /** @brief Liga ou desliga o modo turbo (jogadas sem pausa). */
+    void setTurbo(bool on);
+    bool turbo() const { return turboMode.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Troca o tabuleiro exibido pelo mais recente, se houver um novo (só a janela chama).
+     * @return true se frame() mudou.
+     */
+    bool consume() { return channel.consume(); }
+
+    /** @brief Último tabuleiro consumido. */
+    const AgentFrame &frame() const { return channel.readBuffer(); }
+
+    /** @brief Pede o fim da thread e espera por ela. */
+    void stop();
+
+private:
+    void run();
+    void startNewGame();
+    void publish(bool stuck);
+
+    Game game;
+    AgentContext context;
+    std::mt19937 gen;
+    int stepMs;
+    std::function<void()> notify;
+
+    SnapshotChannel<AgentFrame> channel;
+    std::atomic<bool> turboMode{false};
+    std::mutex mutex;               // Protege restartRequested e stopping.
+    std::condition_variable wake;   // Interrompe as esperas da thread do agente.
+    bool restartRequested = false;
+    bool stopping = false;
+    std::thread thread;
+};
+
+#endif // CAMPO_MINADO_AGENT_THREAD_H
@@ -0,0 +1,217 @@
+/**
+ * @file benchmark.cpp
+ * @brief Implementação do modo de benchmark sem interface gráfica.
+ */
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../comum/game.h"
+#include "../comum/thread_pool.h"
+#include "agent.h"
+
+namespace {
+
+/**
+ * @struct BatchStats
+ * @brief Estatísticas acumuladas por um worker (e, depois de somadas, por tabuleiro).
+ */
+struct BatchStats {
+    int games = 0;
+    int wins = 0;
+    int losses = 0;
+    int stuck = 0;                 // Partidas em que o agente ficou sem nenhuma jogada.
+    long long moves = 0;           // Passos do agente (agentStep com jogada).
+    long long basicMoves = 0;      // Passos resolvidos pelas regras básicas.
+    long long results[3] = {0, 0, 0}; // Frequência de cada MoveResult.
+    long long backends[4] = {0, 0, 0, 0}; // Chamadas ao resolvedor por GuessBackend.
+    long long guaranteedMoves = 0; // Jogadas garantidas executadas pelo resolvedor (várias por chamada).
+    long long components = 0;      // Componentes da fronteira, somados sobre as chamadas ao resolvedor.
+    long long componentsEnumerated = 0; // Desses, os enumerados (os demais vieram do cache do FrontierSolver).
+    std::vector<double> solveSeconds; // Duração de cada chamada a solveByConstraints.
+
+    void merge(const BatchStats &o) {
+        games += o.games;
+        wins += o.wins;
+        losses += o.losses;
+        stuck += o.stuck;
+        moves += o.moves;
+        basicMoves += o.basicMoves;
+        for (int i = 0; i < 3; i++) results[i] += o.results[i];
+        for (int i = 0; i < 4; i++) backends[i] += o.backends[i];
+        guaranteedMoves += o.guaranteedMoves;
+        components += o.components;
+        componentsEnumerated += o.componentsEnumerated;
+        solveSeconds.insert(solveSeconds.end(), o.solveSeconds.begin(), o.solveSeconds.end());
+    }
+};
+
+/**
+ * @brief Converte a lista de --boards em configurações de tabuleiro.
+ * @return false se algum item for inválido (a mensagem de erro já foi impressa).
+ */
+bool parseBoardList(const std::string &list, std::vector<BoardConfig> &boards) {
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        Options single;
+        int w = 0, h = 0, m = 0;
+        char sep1 = 0, sep2 = 0;
+        std::stringstream parts(item);
+        if (parts >> w >> sep1 >> h >> sep2 >> m && sep1 == 'x' && sep2 == '/' && parts.peek() == EOF) {
+            single.values["width"] = std::to_string(w);
+            single.values["height"] = std::to_string(h);
+            single.values["mines"] = std::to_string(m);
+        } else {
+            single.values["board"] = item;
+        }
+        BoardConfig board;
+        if (!readBoardConfig(single, BoardConfig(), board)) return false;
+        boards.push_back(board);
+    }
+    if (boards.empty()) {
+        std::cerr << "--boards nao contem nenhum tabuleiro." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Joga uma partida completa, do primeiro clique até a vitória ou derrota.
+ */
+void playGame(Game &game, std::mt19937 &gen, AgentContext &context, BatchStats &stats) {
+    // O cache de componentes do resolvedor vale só dentro da partida: quais partidas um worker
+    // joga depende do escalonamento, e uma partida que esgota o orçamento de nós poderia
+    // seguir outro caminho conforme o que sobrou da anterior.
+    context.solver.reset();
+    game.initializeGrid();
+    int startX = std::uniform_int_distribution<>(0, game.width - 1)(gen);
+    int startY = std::uniform_int_distribution<>(0, game.height - 1)(gen);
+    game.startGameAt(startX, startY, gen);
+
+    StepReport report;
+    while (!game.gameOver && !game.youWin) {
+        if (!agentStep(game, gen, context, report)) {
+            stats.stuck++;
+            break;
+        }
+        stats.moves++;
+        if (report.basicRule) stats.basicMoves++;
+        if (report.solverCalled) {
+            stats.results[static_cast<int>(report.result)]++;
+            stats.solveSeconds.push_back(report.solveSeconds);
+            stats.backends[static_cast<int>(report.backend)]++;
+            stats.guaranteedMoves += report.guaranteedMoves;
+            stats.components += report.components;
+            stats.componentsEnumerated += report.componentsEnumerated;
+        }
+    }
+    stats.games++;
+    if (game.youWin) stats.wins++;
+    else if (game.gameOver) stats.losses++;
+}
+
+/** @brief Percentil (0-1) por posto mais próximo de um vetor já ordenado. */
+double percentile(const std::vector<double> &sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void printReport(const BoardConfig &board, BatchStats &stats, double seconds) {
+    std::sort(stats.solveSeconds.begin(), stats.solveSeconds.end());
+    auto pct = [&](long long n, long long total) { return total > 0 ? 100.0 * n / total : 0.0; };
+    long long calls = static_cast<long long>(stats.solveSeconds.size());
+
+    std::cout << std::fixed;
+    std::cout << "Tabuleiro " << board.width << "x" << board.height << " (" << board.numMines << " minas): "
+              << stats.games << " jogos em " << std::setprecision(3) << seconds << " s ("
+              << std::setprecision(1) << (seconds > 0 ? stats.games / seconds : 0.0) << " jogos/s)" << std::endl;
+    std::cout << "  Vitorias: " << std::setprecision(2) << pct(stats.wins, stats.games) << "% (" << stats.wins << "/"
+              << stats.games << ")  Derrotas: " << stats.losses << "  Agente preso: " << stats.stuck << std::endl;
+    std::cout << "  Jogadas: " << stats.moves << " (regras basicas: " << stats.basicMoves << ", resolvedor: " << calls << ")" << std::endl;
+    std::cout << "  solveByConstraints: p50 = " << std::setprecision(4) << percentile(stats.solveSeconds, 0.50) * 1e3
+              << " ms, p99 = " << percentile(stats.solveSeconds, 0.99) * 1e3
+              << " ms, max = " << (calls > 0 ? stats.solveSeconds.back() * 1e3 : 0.0) << " ms" << std::endl;
+    std::cout << std::setprecision(2)
+              << "  GUARANTEED_MOVE_FOUND: " << stats.results[0] << " (" << pct(stats.results[0], calls) << "%)"
+              << "  NO_GUARANTEED_MOVE: " << stats.results[1] << " (" << pct(stats.results[1], calls) << "%)"
+              << "  FAILED: " << stats.results[2] << " (" << pct(stats.results[2], calls) << "%)" << std::endl;
+    std::cout << "  Jogadas garantidas: " << stats.guaranteedMoves << " ("
+              << (stats.results[0] > 0 ? static_cast<double>(stats.guaranteedMoves) / stats.results[0] : 0.0)
+              << " por analise)  Componentes: " << stats.components << ", " << stats.componentsEnumerated
+              << " enumerados, " << pct(stats.components - stats.componentsEnumerated, stats.components)
+              << "% reaproveitados" << std::endl;
+    std::cout << "  Estimativas:";
+    for (int i = 0; i < 4; i++) {
+        std::cout << " " << guessBackendName(static_cast<GuessBackend>(i)) << ": " << stats.backends[i] << " ("
+                  << pct(stats.backends[i], calls) << "%)";
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int runBenchmark(const Options &options, const BoardConfig &board, const GuessConfig &guess) {
+    std::vector<BoardConfig> boards;
+    if (options.has("boards")) {
+        if (!parseBoardList(options.getString("boards", ""), boards)) return 1;
+    } else {
+        boards.push_back(board);
+    }
+    int games = options.getInt("games", 1000);
+    long long seed = options.getInt64("seed", 1);
+    if (games < 1) {
+        std::cerr << "--games deve ser pelo menos 1." << std::endl;
+        return 1;
+    }
+    if (seed < 0) {
+        std::cerr << "--seed nao pode ser negativa." << std::endl;
+        return 1;
+    }
+    const unsigned seedLow = static_cast<unsigned>(static_cast<uint64_t>(seed) & 0xFFFFFFFFu);
+    const unsigned seedHigh = static_cast<unsigned>(static_cast<uint64_t>(seed) >> 32);
+
+    ThreadPool pool(options.getInt("threads", 0));
+    std::cout << "=== Benchmark sem interface: " << games << " jogos por tabuleiro, semente " << seed
+              << ", " << pool.size() << " threads ===" << std::endl;
+
+    auto totalStart = std::chrono::steady_clock::now();
+    long long totalGames = 0;
+    for (size_t b = 0; b < boards.size(); b++) {
+        const BoardConfig &cfg = boards[b];
+        std::vector<Game> workerGames(pool.size(), Game(cfg.width, cfg.height, cfg.numMines));
+        std::vector<BatchStats> workerStats(pool.size());
+        std::vector<AgentContext> workerContexts(pool.size());
+        for (AgentContext &context : workerContexts) context.guesser.config = guess;
+
+        auto start = std::chrono::steady_clock::now();
+        pool.parallelFor(games, 0, [&](int worker, int i) {
+            // A semente depende só da partida, não da thread que a joga.
+            std::seed_seq seq{seedLow, seedHigh, static_cast<unsigned>(b), static_cast<unsigned>(i)};
+            std::mt19937 gen(seq);
+            playGame(workerGames[worker], gen, workerContexts[worker], workerStats[worker]);
+        });
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        BatchStats stats;
+        for (const auto &ws : workerStats) stats.merge(ws);
+        printReport(cfg, stats, seconds);
+        totalGames += stats.games;
+    }
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - totalStart).count();
+    std::cout << "Total: " << totalGames << " jogos em " << std::setprecision(3) << totalSeconds << " s ("
+              << std::setprecision(1) << (totalSeconds > 0 ? totalGames / totalSeconds : 0.0) << " jogos/s)" << std::endl;
+    return 0;
+}
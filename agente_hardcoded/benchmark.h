@@ -0,0 +1,39 @@
+/**
+ * @file benchmark.h
+ * @brief Modo de benchmark sem interface gráfica do agente hardcoded.
+ * @details Joga N partidas por tamanho de tabuleiro em todos os núcleos, sem janela, sem
+ * pausas e sem logs por jogada, e imprime jogos/s, taxa de vitória, a latência (p50/p99)
+ * de cada chamada a solveByConstraints, a frequência de cada MoveResult, quantas jogadas
+ * garantidas cada análise rendeu e quantos componentes da fronteira vieram do cache. Cada
+ * partida tem sua própria semente derivada de (semente, tabuleiro, partida) e começa com o
+ * resolvedor zerado, então os resultados de jogo são idênticos com qualquer número de
+ * threads; só os tempos variam
+ * (exceto com --exact-ms ou quando o Monte Carlo é usado, pois os prazos dependem do relógio).
+ * Com --exact-ms, o relatório mostra quantos chutes vieram de cada backend, o que permite
+ * comparar a taxa de vitória com o tempo de resolução em tabuleiros grandes.
+ *
+ * Opções (além de --headless):
+ * - `--games=N` partidas por tabuleiro (padrão 1000);
+ * - `--seed=S` semente base, um inteiro de 64 bits não negativo (padrão 1);
+ * - `--threads=T` número de threads, 0 = todos os núcleos (padrão);
+ * - `--boards=lista` tabuleiros separados por vírgula: presets (beginner, intermediate,
+ *   expert) ou `LxA/minas`, ex: `--boards=beginner,expert,20x20/60`. Sem esta opção, usa o
+ *   tabuleiro de --board/--width/--height/--mines.
+ */
+
+#ifndef CAMPO_MINADO_BENCHMARK_H
+#define CAMPO_MINADO_BENCHMARK_H
+
+#include "../comum/config.h"
+#include "guess.h"
+
+/**
+ * @brief Executa o benchmark e imprime o relatório em std::cout.
+ * @param options As opções lidas da linha de comando.
+ * @param board Tabuleiro usado quando --boards não é informado.
+ * @param guess Backends e orçamentos dos chutes (ver guess.h).
+ * @return Código de saída do programa (0 em caso de sucesso).
+ */
+int runBenchmark(const Options &options, const BoardConfig &board, const GuessConfig &guess);
+
+#endif // CAMPO_MINADO_BENCHMARK_H
@@ -0,0 +1,307 @@
+/**
+ * @file guess.cpp
+ * @brief Implementação dos backends de probabilidade e da escolha do chute.
+ */
+
+#include "guess.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "../comum/rng.h"
+
+namespace {
+
+/** @brief Temperatura inversa do Metropolis: cada restrição violada divide o peso por e^BETA. */
+const double BETA = 1.5;
+
+double logBinomial(int n, int k) {
+    return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+}
+
+/** @brief Número de vizinhos ocultos (sem bandeira) de uma casa. */
+int hiddenNeighbors(const Game &game, int idx) {
+    int count = 0;
+    for (int offset : game.neighborOffsets) count += game.state(idx + offset) == HIDDEN;
+    return count;
+}
+
+} // namespace
+
+const char* guessBackendName(GuessBackend backend) {
+    switch (backend) {
+        case GuessBackend::EXACT: return "exato";
+        case GuessBackend::MONTE_CARLO: return "Monte Carlo";
+        case GuessBackend::DENSITY: return "densidade";
+        case GuessBackend::RANDOM: return "aleatorio";
+    }
+    return "?";
+}
+
+bool readGuessConfig(const Options &options, GuessConfig &config) {
+    const std::string first = options.getString("guess", "exact");
+    if (first == "exact") config.first = GuessBackend::EXACT;
+    else if (first == "montecarlo") config.first = GuessBackend::MONTE_CARLO;
+    else if (first == "density") config.first = GuessBackend::DENSITY;
+    else {
+        std::cerr << "Backend de chute desconhecido: " << first << " (use exact, montecarlo ou density)" << std::endl;
+        return false;
+    }
+    config.exactNodes = options.getInt64("exact-nodes", config.exactNodes);
+    config.exactMs = options.getDouble("exact-ms", config.exactMs);
+    config.monteCarloMs = options.getDouble("mc-ms", config.monteCarloMs);
+    config.monteCarloSteps = options.getInt64("mc-steps", config.monteCarloSteps);
+    if (config.exactNodes < 1 || config.monteCarloSteps < 1) {
+        std::cerr << "--exact-nodes e --mc-steps devem ser pelo menos 1." << std::endl;
+        return false;
+    }
+    if (config.exactMs < 0.0 || config.monteCarloMs < 0.0) {
+        std::cerr << "--exact-ms e --mc-ms nao podem ser negativos." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+GuessBackend GuessEngine::estimate(const Game &game, FrontierSolver &solver, std::mt19937 &gen, FrontierSolution &out) {
+    if (config.first == GuessBackend::EXACT && solver.solve(game, out, config.exactNodes, config.exactMs / 1000.0)) {
+        return GuessBackend::EXACT;
+    }
+    if (config.first != GuessBackend::DENSITY && estimateMonteCarlo(game, gen, out)) return GuessBackend::MONTE_CARLO;
+    if (estimateDensity(game, out)) return GuessBackend::DENSITY;
+    return GuessBackend::RANDOM;
+}
+
+int GuessEngine::chooseGuess(const Game &game, const FrontierSolution &solution, double &probability) const {
+    const double EPS = 1e-9;
+    int best = -1;
+    int bestHidden = 9;
+    probability = 1.0;
+    auto consider = [&](int idx, double p) {
+        if (best >= 0 && p > probability + EPS) return;
+        int hidden = hiddenNeighbors(game, idx);
+        if (best < 0 || p < probability - EPS || hidden < bestHidden) {
+            best = idx;
+            bestHidden = hidden;
+            probability = p;
+        }
+    };
+    for (size_t i = 0; i < solution.frontier.size(); i++) consider(solution.frontier[i], solution.mineProbability[i]);
+    for (int idx : solution.interior) consider(idx, solution.interiorProbability);
+    return best;
+}
+
+bool GuessEngine::buildConstraints(const Game &game, FrontierSolution &out) {
+    out.frontier.clear();
+    out.mineProbability.clear();
+    out.interior.clear();
+    out.interiorProbability = 0.0;
+    out.components = 0;
+    out.componentsEnumerated = 0;
+    constraintCells.clear();
+    constraintNeed.clear();
+
+    // 1. Restrições: casas reveladas com vizinhos ocultos. As ocultas vizinhas são marcadas com -2.
+    varIndex.assign(game.cells.size(), -1);
+    for (int y = 0; y < game.height; y++) {
+        for (int x = 0; x < game.width; x++) {
+            const int idx = game.index(x, y);
+            if (game.state(idx) != REVEALED || game.isMine(idx)) continue;
+            int hidden = 0, flags = 0;
+            for (int offset : game.neighborOffsets) {
+                const CellState s = game.state(idx + offset);
+                hidden += s == HIDDEN;
+                flags += s == FLAGGED;
+            }
+            if (hidden == 0) continue;
+            const int need = game.neighboringMines(idx) - flags;
+            if (need < 0 || need > hidden) return false;
+            constraintCells.push_back(idx);
+            constraintNeed.push_back(need);
+            for (int offset : game.neighborOffsets) {
+                if (game.state(idx + offset) == HIDDEN) varIndex[idx + offset] = -2;
+            }
+        }
+    }
+
+    // 2. Fronteira e interior em ordem de índice, como no FrontierSolver.
+    for (int y = 0; y < game.height; y++) {
+        for (int x = 0; x < game.width; x++) {
+            const int idx = game.index(x, y);
+            if (game.state(idx) != HIDDEN) continue;
+            if (varIndex[idx] == -2) {
+                varIndex[idx] = static_cast<int>(out.frontier.size());
+                out.frontier.push_back(idx);
+            } else {
+                out.interior.push_back(idx);
+            }
+        }
+    }
+
+    // 3. Listas de adjacência nos dois sentidos (casas de cada restrição e restrições de cada casa).
+    const int constraints = static_cast<int>(constraintCells.size());
+    const int vars = static_cast<int>(out.frontier.size());
+    constraintStart.assign(constraints + 1, 0);
+    constraintVars.clear();
+    varStart.assign(vars + 1, 0);
+    for (int c = 0; c < constraints; c++) {
+        for (int offset : game.neighborOffsets) {
+            const int n = constraintCells[c] + offset;
+            if (game.state(n) != HIDDEN) continue;
+            constraintVars.push_back(varIndex[n]);
+            varStart[varIndex[n] + 1]++;
+        }
+        constraintStart[c + 1] = static_cast<int>(constraintVars.size());
+    }
+    for (int v = 0; v < vars; v++) varStart[v + 1] += varStart[v];
+    varConstraints.assign(constraintVars.size(), 0);
+    std::vector<int> fill(varStart.begin(), varStart.end() - 1);
+    for (int c = 0; c < constraints; c++) {
+        for (int i = constraintStart[c]; i < constraintStart[c + 1]; i++) varConstraints[fill[constraintVars[i]]++] = c;
+    }
+    return true;
+}
+
+bool GuessEngine::estimateMonteCarlo(const Game &game, std::mt19937 &gen, FrontierSolution &out) {
+    if (config.monteCarloMs <= 0.0) return false;
+    if (!buildConstraints(game, out)) return false;
+    const int vars = static_cast<int>(out.frontier.size());
+    const int interior = static_cast<int>(out.interior.size());
+    const int minesLeft = game.numMines - game.flagsPlaced;
+    const int mMin = std::max(0, minesLeft - interior);
+    const int mMax = std::min(vars, minesLeft);
+    if (vars + interior == 0 || minesLeft < 0 || mMin > mMax) return false;
+    if (vars == 0) {
+        out.interiorProbability = static_cast<double>(minesLeft) / interior;
+        return true;
+    }
+
+    // Peso de cada total m de minas na fronteira: C(interior, minesLeft - m).
+    std::vector<double> logWeight(vars + 1, -INFINITY);
+    for (int m = mMin; m <= mMax; m++) logWeight[m] = logBinomial(interior, minesLeft - m);
+
+    Xoshiro256 rng((static_cast<uint64_t>(gen()) << 32) | gen());
+    auto uniform = [&rng]() { return static_cast<double>(rng() >> 11) * 0x1p-53; };
+
+    // 1. Estado inicial: a densidade esperada de minas, em casas sorteadas da fronteira.
+    int mines = static_cast<int>(std::lround(static_cast<double>(vars) * minesLeft / (vars + interior)));
+    mines = std::min(std::max(mines, mMin), mMax);
+    assignment.assign(vars, 0);
+    std::vector<int> order(vars);
+    for (int v = 0; v < vars; v++) order[v] = v;
+    for (int i = 0; i < mines; i++) {
+        std::swap(order[i], order[i + rng() % (vars - i)]);
+        assignment[order[i]] = 1;
+    }
+    placed.assign(constraintNeed.size(), 0);
+    for (int v = 0; v < vars; v++) {
+        if (!assignment[v]) continue;
+        for (int i = varStart[v]; i < varStart[v + 1]; i++) placed[varConstraints[i]]++;
+    }
+    int violation = 0;
+    for (size_t c = 0; c < placed.size(); c++) violation += std::abs(placed[c] - constraintNeed[c]);
+
+    // 2. Metropolis sobre {configurações da fronteira}, com alvo proporcional a
+    // C(interior, minesLeft - m) * e^(-BETA * restrições violadas). Só os estados sem
+    // violação entram nas médias, e nesses o alvo é exatamente o das probabilidades reais.
+    // Propostas: inverter uma casa, ou inverter um par (vizinho por restrição ou qualquer).
+    mineTime.assign(vars, 0.0);
+    lastChange.assign(vars, 0);
+    long long samples = 0;
+    double frontierMines = 0.0;
+    const long long burnIn = 20LL * vars;
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(config.monteCarloMs / 1000.0));
+    auto flipDelta = [&](int v, int sign) {
+        int delta = 0;
+        for (int i = varStart[v]; i < varStart[v + 1]; i++) {
+            const int c = varConstraints[i];
+            const int before = std::abs(placed[c] - constraintNeed[c]);
+            placed[c] += sign;
+            delta += std::abs(placed[c] - constraintNeed[c]) - before;
+        }
+        return delta;
+    };
+    for (long long step = 0; step < config.monteCarloSteps; step++) {
+        if ((step & 1023) == 0 && std::chrono::steady_clock::now() > deadline) break;
+        const uint64_t r = rng();
+        const int v = static_cast<int>(r % vars);
+        int u = -1;
+        switch ((r >> 40) & 3) {
+            case 0: break; // Só v.
+            case 3: u = static_cast<int>((r >> 8) % vars); break;
+            default: {
+                const int degree = varStart[v + 1] - varStart[v];
+                const int c = varConstraints[varStart[v] + static_cast<int>((r >> 8) % degree)];
+                const int size = constraintStart[c + 1] - constraintStart[c];
+                u = constraintVars[constraintStart[c] + static_cast<int>((r >> 24) % size)];
+                break;
+            }
+        }
+        if (u == v) u = -1;
+
+        const int signV = assignment[v] ? -1 : 1;
+        const int signU = u >= 0 ? (assignment[u] ? -1 : 1) : 0;
+        const int next = mines + signV + signU;
+        if (next >= mMin && next <= mMax) {
+            int delta = flipDelta(v, signV);
+            if (u >= 0) delta += flipDelta(u, signU);
+            const double logAccept = logWeight[next] - logWeight[mines] - BETA * delta;
+            if (logAccept >= 0.0 || uniform() < std::exp(logAccept)) {
+                for (int w : {v, u}) {
+                    if (w < 0) continue;
+                    if (assignment[w]) mineTime[w] += static_cast<double>(samples - lastChange[w]);
+                    lastChange[w] = samples;
+                    assignment[w] ^= 1;
+                }
+                mines = next;
+                violation += delta;
+            } else {
+                flipDelta(v, -signV);
+                if (u >= 0) flipDelta(u, -signU);
+            }
+        }
+        if (violation == 0 && step >= burnIn) {
+            samples++;
+            frontierMines += mines;
+        }
+    }
+    if (samples == 0) return false;
+
+    out.mineProbability.resize(vars);
+    for (int v = 0; v < vars; v++) {
+        if (assignment[v]) mineTime[v] += static_cast<double>(samples - lastChange[v]);
+        out.mineProbability[v] = mineTime[v] / samples;
+    }
+    if (interior > 0) out.interiorProbability = (minesLeft - frontierMines / samples) / interior;
+    return true;
+}
+
+bool GuessEngine::estimateDensity(const Game &game, FrontierSolution &out) {
+    if (!buildConstraints(game, out)) return false;
+    const int vars = static_cast<int>(out.frontier.size());
+    const int interior = static_cast<int>(out.interior.size());
+    const int minesLeft = game.numMines - game.flagsPlaced;
+    if (vars + interior == 0 || minesLeft < 0) return false;
+
+    // Cada casa da fronteira fica com a pior razão minas/casas ocultas entre suas restrições;
+    // o interior divide o que sobra das minas restantes.
+    out.mineProbability.assign(vars, 0.0);
+    for (size_t c = 0; c < constraintNeed.size(); c++) {
+        const int size = constraintStart[c + 1] - constraintStart[c];
+        const double ratio = static_cast<double>(constraintNeed[c]) / size;
+        for (int i = constraintStart[c]; i < constraintStart[c + 1]; i++) {
+            double &p = out.mineProbability[constraintVars[i]];
+            p = std::max(p, ratio);
+        }
+    }
+    if (interior > 0) {
+        double frontierMines = 0.0;
+        for (double p : out.mineProbability) frontierMines += p;
+        out.interiorProbability = std::min(1.0, std::max(0.0, (minesLeft - frontierMines) / interior));
+    }
+    return true;
+}
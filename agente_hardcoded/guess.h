@@ -0,0 +1,123 @@
+/**
+ * @file guess.h
+ * @brief Estimativas de probabilidade de mina para os chutes do agente hardcoded.
+ * @details Quando não há jogada garantida, o agente precisa de P(mina) de cada casa oculta
+ * para chutar a menos arriscada. Há três backends, tentados em ordem até um dar certo:
+ *
+ * 1. **exato** (EXACT): o FrontierSolver (solver.h), com orçamento de nós e de tempo;
+ * 2. **Monte Carlo** (MONTE_CARLO): amostragem de configurações consistentes da fronteira
+ *    por Metropolis, limitada por tempo e por número de passos;
+ * 3. **densidade** (DENSITY): estimativa local para a fronteira (a pior razão
+ *    minas/casas ocultas entre as restrições vizinhas) e densidade global das minas
+ *    restantes para o interior.
+ *
+ * Só o backend exato prova jogadas (probabilidade 0 ou 1); os outros só orientam o chute.
+ * Se nenhum der certo, o agente revela uma casa aleatória, como antes. Entre casas com a
+ * mesma probabilidade, o chute prefere a de menos vizinhos ocultos (cantos e bordas), que
+ * tem mais chance de ser um zero e abrir uma região.
+ *
+ * Opções da linha de comando (ver readGuessConfig):
+ * - `--guess=exact|montecarlo|density` primeiro backend da cadeia (padrão exact);
+ * - `--exact-nodes=N` orçamento de nós do backend exato (padrão 20000000);
+ * - `--exact-ms=T` prazo do backend exato por jogada, 0 = sem limite (padrão);
+ * - `--mc-ms=T` prazo do Monte Carlo por jogada, 0 = desligado (padrão 20);
+ * - `--mc-steps=N` máximo de passos do Monte Carlo por jogada (padrão 2000000).
+ */
+
+#ifndef CAMPO_MINADO_GUESS_H
+#define CAMPO_MINADO_GUESS_H
+
+#include <random>
+#include <vector>
+
+#include "../comum/config.h"
+#include "../comum/game.h"
+#include "solver.h"
+
+/**
+ * @enum GuessBackend
+ * @brief Origem das probabilidades usadas em uma jogada.
+ */
+enum class GuessBackend {
+    EXACT,       // Resolvedor exato (as probabilidades 0 e 1 são provas).
+    MONTE_CARLO, // Amostragem aproximada.
+    DENSITY,     // Estimativa local e densidade global.
+    RANDOM       // Nenhum backend deu certo: casa aleatória.
+};
+
+/** @brief Nome curto do backend, para logs e relatórios. */
+const char* guessBackendName(GuessBackend backend);
+
+/**
+ * @struct GuessConfig
+ * @brief Cadeia de backends e orçamento de cada um por jogada.
+ */
+struct GuessConfig {
+    GuessBackend first = GuessBackend::EXACT; // Primeiro backend tentado (os anteriores são pulados).
+    long long exactNodes = 20000000;
+    double exactMs = 0.0;                     // 0: sem limite de tempo.
+    double monteCarloMs = 20.0;               // 0: Monte Carlo desligado.
+    long long monteCarloSteps = 2000000;
+};
+
+/**
+ * @brief Lê a configuração dos chutes das opções (ver as opções em guess.h).
+ * @return false se algum valor for inválido (a mensagem de erro já foi impressa).
+ */
+bool readGuessConfig(const Options &options, GuessConfig &config);
+
+/**
+ * @class GuessEngine
+ * @brief Executa a cadeia de backends e escolhe a casa do chute.
+ * @details Guarda os vetores de trabalho do Monte Carlo entre as jogadas. Não é
+ * thread-safe; use um por thread, como o FrontierSolver.
+ */
+class GuessEngine {
+public:
+    explicit GuessEngine(const GuessConfig &config = GuessConfig()) : config(config) {}
+
+    /**
+     * @brief Calcula P(mina) das casas ocultas com o primeiro backend que der certo.
+     * @param game O estado atual do jogo (não é alterado).
+     * @param solver Resolvedor exato da partida.
+     * @param gen Gerador do Monte Carlo.
+     * @param out Recebe a fronteira, o interior e as probabilidades (como em FrontierSolver::solve).
+     * @return O backend usado; RANDOM se nenhum deu certo (`out` fica indefinido).
+     */
+    GuessBackend estimate(const Game &game, FrontierSolver &solver, std::mt19937 &gen, FrontierSolution &out);
+
+    /**
+     * @brief Escolhe a casa oculta de menor probabilidade, desempatando por menos vizinhos ocultos.
+     * @param probability Recebe a P(mina) da casa escolhida.
+     * @return O índice (Game::index) da casa, ou -1 se `solution` não tem casas.
+     */
+    int chooseGuess(const Game &game, const FrontierSolution &solution, double &probability) const;
+
+    /** @brief Backend Monte Carlo isolado; false se não amostrou nenhuma configuração consistente. */
+    bool estimateMonteCarlo(const Game &game, std::mt19937 &gen, FrontierSolution &out);
+
+    /** @brief Backend de densidade isolado; false se o tabuleiro é inconsistente. */
+    bool estimateDensity(const Game &game, FrontierSolution &out);
+
+    GuessConfig config;
+
+private:
+    bool buildConstraints(const Game &game, FrontierSolution &out);
+
+    // Restrições da fronteira, montadas a cada chamada a partir do tabuleiro.
+    std::vector<int> varIndex;                   // Posição de cada casa em out.frontier (-1: fora da fronteira).
+    std::vector<int> constraintCells;            // Casa revelada de cada restrição.
+    std::vector<int> constraintNeed;             // Minas que faltam em volta de cada restrição.
+    std::vector<int> constraintStart;            // Casas de cada restrição em constraintVars[start[c], start[c+1]).
+    std::vector<int> constraintVars;
+    std::vector<int> varStart;                   // Restrições de cada casa em varConstraints[start[v], start[v+1]).
+    std::vector<int> varConstraints;
+
+    // Estado do Metropolis.
+    std::vector<char> assignment;
+    std::vector<int> placed;
+    std::vector<double> mineTime;
+    std::vector<long long> lastChange;
+};
+
+#endif // CAMPO_MINADO_GUESS_H
@@ -0,0 +1,503 @@
+/**
+ * @file solver.cpp
+ * @brief Implementação do resolvedor de restrições da fronteira.
+ */
+
+#include "solver.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../comum/bitboard.h"
+
+namespace {
+
+/**
+ * @struct LocalConstraint
+ * @brief Restrição de um componente, com as casas numeradas na ordem da busca.
+ */
+struct LocalConstraint {
+    std::vector<int> vars;
+    int need;
+};
+
+/**
+ * @struct BitComponentSearch
+ * @brief Backtracking sobre um componente de até 64 * W casas, com as minas em um Bitboard.
+ * @details As casas são atribuídas na ordem da busca em largura que encontrou o componente,
+ * então as restrições vão sendo fechadas cedo e a poda parcial corta a maior parte da árvore.
+ * Como a ordem é fixa, o número de casas de cada restrição que ainda faltam decidir depois
+ * da casa `pos` é uma constante pré-calculada; cada checagem é um único
+ * countAnd(minas, vizinhos) e o estado da busca é só o Bitboard, passado por valor.
+ */
+template <int W>
+struct BitComponentSearch {
+    struct Check {
+        int constraint;
+        int openAfter; // Casas da restrição com índice maior que a casa atribuída.
+    };
+
+    int size = 0;
+    std::vector<Bitboard<W>> neighborMask; // Casas de cada restrição.
+    std::vector<int> need;
+    std::vector<std::vector<Check>> checks; // Restrições que contêm cada casa.
+    ComponentCounts *counts = nullptr;
+    int maxMines = 0;
+    SearchBudget *budget = nullptr;
+    bool aborted = false;
+
+    BitComponentSearch(int n, const std::vector<LocalConstraint> &constraints) : size(n), checks(n) {
+        for (size_t c = 0; c < constraints.size(); c++) {
+            Bitboard<W> mask;
+            for (int v : constraints[c].vars) mask.set(v);
+            neighborMask.push_back(mask);
+            need.push_back(constraints[c].need);
+            for (int v : constraints[c].vars) {
+                int openAfter = 0;
+                for (int u : constraints[c].vars) openAfter += u > v;
+                checks[v].push_back({static_cast<int>(c), openAfter});
+            }
+        }
+    }
+
+    void search(int pos, const Bitboard<W> &mines, int mineCount) {
+        if (aborted) return;
+        if (!budget->spend()) { aborted = true; return; }
+        if (pos == size) {
+            counts->solutions[mineCount] += 1.0;
+            std::vector<double> &row = counts->mineCounts[mineCount];
+            mines.forEach([&row](int v) { row[v] += 1.0; });
+            return;
+        }
+        for (int value = 0; value <= 1; value++) {
+            if (value == 1 && mineCount == maxMines) break;
+            Bitboard<W> next = mines;
+            if (value == 1) next.set(pos);
+            bool consistent = true;
+            for (const Check &check : checks[pos]) {
+                int placed = countAnd(next, neighborMask[check.constraint]);
+                int required = need[check.constraint];
+                if (placed > required || placed + check.openAfter < required) { consistent = false; break; }
+            }
+            if (consistent) search(pos + 1, next, mineCount + value);
+        }
+    }
+};
+
+/**
+ * @struct CounterComponentSearch
+ * @brief Mesmo backtracking para componentes maiores que 256 casas, com contadores
+ * incrementais por restrição em vez de máscaras.
+ */
+struct CounterComponentSearch {
+    std::vector<std::vector<int>> varConstraints; // Restrições que contêm cada casa.
+    std::vector<int> need;                        // Minas exigidas por restrição.
+    std::vector<int> placed;                      // Minas já atribuídas por restrição.
+    std::vector<int> open;                        // Casas ainda não atribuídas por restrição.
+    std::vector<char> assignment;
+    ComponentCounts *counts = nullptr;
+    int maxMines = 0;
+    SearchBudget *budget = nullptr;
+    bool aborted = false;
+
+    CounterComponentSearch(int n, const std::vector<LocalConstraint> &constraints) : varConstraints(n), assignment(n, 0) {
+        for (size_t c = 0; c < constraints.size(); c++) {
+            need.push_back(constraints[c].need);
+            placed.push_back(0);
+            open.push_back(static_cast<int>(constraints[c].vars.size()));
+            for (int v : constraints[c].vars) varConstraints[v].push_back(static_cast<int>(c));
+        }
+    }
+
+    void search(int pos, int mines) {
+        if (aborted) return;
+        if (!budget->spend()) { aborted = true; return; }
+        int n = static_cast<int>(assignment.size());
+        if (pos == n) {
+            counts->solutions[mines] += 1.0;
+            for (int v = 0; v < n; v++) counts->mineCounts[mines][v] += assignment[v];
+            return;
+        }
+        for (int value = 0; value <= 1; value++) {
+            if (value == 1 && mines == maxMines) break;
+            bool consistent = true;
+            for (int c : varConstraints[pos]) {
+                placed[c] += value;
+                open[c]--;
+                if (placed[c] > need[c] || placed[c] + open[c] < need[c]) consistent = false;
+            }
+            if (consistent) {
+                assignment[pos] = static_cast<char>(value);
+                search(pos + 1, mines + value);
+            }
+            for (int c : varConstraints[pos]) {
+                placed[c] -= value;
+                open[c]++;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Enumera um componente com a representação adequada ao seu tamanho.
+ * @return false se o orçamento se esgotou.
+ */
+bool enumerateComponent(int n, const std::vector<LocalConstraint> &constraints, int maxMines,
+                        SearchBudget &budget, ComponentCounts &counts) {
+    auto run = [&](auto search) {
+        search.counts = &counts;
+        search.maxMines = maxMines;
+        search.budget = &budget;
+        return search;
+    };
+    if (n <= 64) {
+        auto search = run(BitComponentSearch<1>(n, constraints));
+        search.search(0, Bitboard<1>(), 0);
+        return !search.aborted;
+    }
+    if (n <= 128) {
+        auto search = run(BitComponentSearch<2>(n, constraints));
+        search.search(0, Bitboard<2>(), 0);
+        return !search.aborted;
+    }
+    if (n <= 256) {
+        auto search = run(BitComponentSearch<4>(n, constraints));
+        search.search(0, Bitboard<4>(), 0);
+        return !search.aborted;
+    }
+    auto search = run(CounterComponentSearch(n, constraints));
+    search.search(0, 0);
+    return !search.aborted;
+}
+
+std::vector<double> convolve(const std::vector<double> &a, const std::vector<double> &b) {
+    std::vector<double> result(a.size() + b.size() - 1, 0.0);
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i] == 0.0) continue;
+        for (size_t j = 0; j < b.size(); j++) result[i + j] += a[i] * b[j];
+    }
+    return result;
+}
+
+double logBinomial(int n, int k) {
+    return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+}
+
+const uint8_t CODE_UNKNOWN = 0xFF; // Casa ainda não vista pelo resolvedor.
+
+/** @brief Estado e número de uma casa em um byte: 0 oculta, 1 bandeira, 2 + n revelada (11: mina). */
+uint8_t cellCode(const Game &game, int idx) {
+    switch (game.state(idx)) {
+        case HIDDEN: return 0;
+        case FLAGGED: return 1;
+        default: return static_cast<uint8_t>(2 + (game.isMine(idx) ? 9 : game.neighboringMines(idx)));
+    }
+}
+
+bool impossible(int need, uint8_t mask) { return need < 0 || need > __builtin_popcount(mask); }
+
+} // namespace
+
+void FrontierSolver::reset() {
+    width = height = -1;
+}
+
+void FrontierSolver::resize(const Game &game) {
+    if (game.width == width && game.height == height && seen.size() == game.cells.size()) return;
+    width = game.width;
+    height = game.height;
+    const size_t size = game.cells.size();
+    inside.assign(size, 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) inside[game.index(x, y)] = 1;
+    }
+    seen.assign(size, CODE_UNKNOWN);
+    varMask.assign(size, 0);
+    need.assign(size, 0);
+    degree.assign(size, 0);
+    componentOf.assign(size, -1);
+    stamp.assign(size, 0);
+    localIndex.assign(size, -1);
+    flatProbability.assign(size, 0.0);
+    components.clear();
+    freeComponents.clear();
+    seeds.clear();
+    inconsistent = 0;
+}
+
+int FrontierSolver::newComponent() {
+    int id;
+    if (!freeComponents.empty()) {
+        id = freeComponents.back();
+        freeComponents.pop_back();
+    } else {
+        id = static_cast<int>(components.size());
+        components.emplace_back();
+    }
+    Component &component = components[id];
+    component.vars.clear();
+    component.constraints.clear();
+    component.enumeratedMaxMines = -1;
+    component.alive = true;
+    return id;
+}
+
+void FrontierSolver::dissolve(int id) {
+    Component &component = components[id];
+    for (int v : component.vars) {
+        componentOf[v] = -1;
+        seeds.push_back(v);
+    }
+    component.vars.clear();
+    component.constraints.clear();
+    component.enumeratedMaxMines = -1;
+    component.alive = false;
+    freeComponents.push_back(id);
+}
+
+void FrontierSolver::updateConstraint(const Game &game, int idx) {
+    uint8_t mask = 0;
+    int needNow = 0;
+    if (game.state(idx) == REVEALED && !game.isMine(idx)) {
+        needNow = game.neighboringMines(idx);
+        for (int i = 0; i < 8; i++) {
+            CellState s = game.state(idx + game.neighborOffsets[i]);
+            if (s == FLAGGED) needNow--;
+            else if (s == HIDDEN) mask |= static_cast<uint8_t>(1 << i);
+        }
+    }
+    const uint8_t old = varMask[idx];
+    if (mask == old && (mask == 0 || needNow == need[idx])) return; // Restrição inalterada.
+
+    // Os componentes que continham a restrição antiga ou que a nova encosta deixam de valer.
+    if (old && impossible(need[idx], old)) inconsistent--;
+    for (int i = 0; i < 8; i++) {
+        const int n = idx + game.neighborOffsets[i];
+        if (old & (1 << i)) degree[n]--;
+        if (mask & (1 << i)) {
+            degree[n]++;
+            seeds.push_back(n);
+        }
+        if (((old | mask) & (1 << i)) && componentOf[n] >= 0) dissolve(componentOf[n]);
+    }
+    varMask[idx] = mask;
+    need[idx] = needNow;
+    if (mask && impossible(needNow, mask)) inconsistent++;
+}
+
+void FrontierSolver::sync(const Game &game) {
+    changed.clear();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const int idx = game.index(x, y);
+            const uint8_t code = cellCode(game, idx);
+            if (code == seen[idx]) continue;
+            seen[idx] = code;
+            changed.push_back(idx);
+        }
+    }
+    // Só as restrições das casas alteradas e de suas vizinhas podem ter mudado.
+    ++stampValue;
+    for (int idx : changed) {
+        for (int i = -1; i < 8; i++) {
+            const int t = i < 0 ? idx : idx + game.neighborOffsets[i];
+            if (!inside[t] || stamp[t] == stampValue) continue;
+            stamp[t] = stampValue;
+            updateConstraint(game, t);
+        }
+    }
+}
+
+void FrontierSolver::rebuildComponents(const Game &game) {
+    // Busca em largura casa -> restrição -> casa, só a partir das casas que perderam o componente.
+    for (size_t s = 0; s < seeds.size(); s++) {
+        const int start = seeds[s];
+        if (componentOf[start] >= 0 || degree[start] == 0 || game.state(start) != HIDDEN) continue;
+        const int id = newComponent();
+        ++stampValue;
+        componentOf[start] = id;
+        components[id].vars.push_back(start);
+        for (size_t head = 0; head < components[id].vars.size(); head++) {
+            const int v = components[id].vars[head];
+            for (int offset : game.neighborOffsets) {
+                const int k = v + offset;
+                if (!varMask[k] || stamp[k] == stampValue) continue;
+                stamp[k] = stampValue;
+                components[id].constraints.push_back(k);
+                for (int j = 0; j < 8; j++) {
+                    if (!(varMask[k] & (1 << j))) continue;
+                    const int u = k + game.neighborOffsets[j];
+                    if (componentOf[u] == id) continue;
+                    if (componentOf[u] >= 0) dissolve(componentOf[u]); // Outro componente que passou a se ligar a este.
+                    componentOf[u] = id;
+                    components[id].vars.push_back(u);
+                }
+            }
+        }
+    }
+    seeds.clear();
+}
+
+bool FrontierSolver::enumerate(const Game &game, Component &component, int maxMines, SearchBudget &budget) {
+    const int n = static_cast<int>(component.vars.size());
+    for (int i = 0; i < n; i++) localIndex[component.vars[i]] = i;
+    std::vector<LocalConstraint> local(component.constraints.size());
+    for (size_t c = 0; c < component.constraints.size(); c++) {
+        const int k = component.constraints[c];
+        local[c].need = need[k];
+        for (int j = 0; j < 8; j++) {
+            if (varMask[k] & (1 << j)) local[c].vars.push_back(localIndex[k + game.neighborOffsets[j]]);
+        }
+    }
+    component.counts.solutions.assign(maxMines + 1, 0.0);
+    component.counts.mineCounts.assign(maxMines + 1, std::vector<double>(n, 0.0));
+    if (!enumerateComponent(n, local, maxMines, budget, component.counts)) {
+        component.enumeratedMaxMines = -1;
+        return false;
+    }
+    component.enumeratedMaxMines = maxMines;
+    return true;
+}
+
+bool FrontierSolver::solve(const Game &game, FrontierSolution &out, long long nodeBudget, double timeBudgetSeconds) {
+    out.frontier.clear();
+    out.mineProbability.clear();
+    out.interior.clear();
+    out.interiorProbability = 0.0;
+    out.components = 0;
+    out.componentsEnumerated = 0;
+
+    // 1. Atualiza restrições e componentes a partir das casas que mudaram.
+    resize(game);
+    sync(game);
+    rebuildComponents(game);
+    if (inconsistent > 0) return false;
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const int idx = game.index(x, y);
+            if (game.state(idx) != HIDDEN) continue;
+            if (componentOf[idx] >= 0) out.frontier.push_back(idx);
+            else out.interior.push_back(idx);
+        }
+    }
+    const int frontierSize = static_cast<int>(out.frontier.size());
+    const int interiorSize = static_cast<int>(out.interior.size());
+    const int minesLeft = game.numMines - game.flagsPlaced;
+    if (frontierSize + interiorSize == 0 || minesLeft < 0) return false;
+
+    // 2. Componentes vivos, em uma ordem que só depende do tabuleiro (a menor casa de cada um).
+    std::vector<std::pair<int, int>> order;
+    for (int id = 0; id < static_cast<int>(components.size()); id++) {
+        if (!components[id].alive) continue;
+        const std::vector<int> &vars = components[id].vars;
+        order.emplace_back(*std::min_element(vars.begin(), vars.end()), id);
+    }
+    std::sort(order.begin(), order.end());
+    out.components = static_cast<int>(order.size());
+
+    // 3. Enumera só os componentes sem resultado guardado (ou guardado com limite de minas menor).
+    SearchBudget budget;
+    budget.nodesLeft = nodeBudget;
+    if (timeBudgetSeconds > 0.0) {
+        budget.timed = true;
+        budget.deadline = std::chrono::steady_clock::now() +
+                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeBudgetSeconds));
+    }
+    for (const auto &entry : order) {
+        Component &component = components[entry.second];
+        const int maxMines = std::min(static_cast<int>(component.vars.size()), minesLeft);
+        if (component.enumeratedMaxMines >= maxMines) continue;
+        if (!enumerate(game, component, maxMines, budget)) return false;
+        out.componentsEnumerated++;
+    }
+
+    // 4. Peso do interior para cada total m de minas na fronteira: C(interior, minesLeft - m),
+    // em escala relativa ao maior valor para não estourar o double.
+    std::vector<double> interiorWeight(frontierSize + 1, 0.0);
+    double maxLog = -INFINITY;
+    for (int m = 0; m <= frontierSize; m++) {
+        int rest = minesLeft - m;
+        if (rest >= 0 && rest <= interiorSize) maxLog = std::max(maxLog, logBinomial(interiorSize, rest));
+    }
+    if (maxLog == -INFINITY) return false;
+    for (int m = 0; m <= frontierSize; m++) {
+        int rest = minesLeft - m;
+        if (rest >= 0 && rest <= interiorSize) interiorWeight[m] = std::exp(logBinomial(interiorSize, rest) - maxLog);
+    }
+
+    // 5. Combinação: distribuições normalizadas por componente (só até minesLeft minas),
+    // prefixos e sufixos da convolução.
+    const size_t count = order.size();
+    std::vector<std::vector<double>> dist(count);
+    std::vector<double> scale(count, 1.0);
+    for (size_t c = 0; c < count; c++) {
+        const Component &component = components[order[c].second];
+        const size_t kMax = std::min(component.vars.size(), static_cast<size_t>(minesLeft));
+        dist[c].assign(component.counts.solutions.begin(), component.counts.solutions.begin() + kMax + 1);
+        double top = *std::max_element(dist[c].begin(), dist[c].end());
+        if (top == 0.0) return false; // Componente sem nenhuma solução: tabuleiro inconsistente.
+        scale[c] = top;
+        for (double &w : dist[c]) w /= top;
+    }
+    std::vector<std::vector<double>> prefix(count + 1), suffix(count + 1);
+    prefix[0] = {1.0};
+    for (size_t c = 0; c < count; c++) prefix[c + 1] = convolve(prefix[c], dist[c]);
+    suffix[count] = {1.0};
+    for (size_t c = count; c-- > 0;) suffix[c] = convolve(dist[c], suffix[c + 1]);
+
+    const std::vector<double> &all = prefix[count];
+    double total = 0.0;
+    double interiorMines = 0.0;
+    bool interiorCanBeSafe = false, interiorCanBeMine = false;
+    for (size_t m = 0; m < all.size(); m++) {
+        double w = all[m] * interiorWeight[m];
+        if (w <= 0.0) continue;
+        total += w;
+        int rest = minesLeft - static_cast<int>(m);
+        interiorMines += w * rest;
+        if (rest < interiorSize) interiorCanBeSafe = true;
+        if (rest > 0) interiorCanBeMine = true;
+    }
+    if (total <= 0.0) return false;
+    if (interiorSize > 0) {
+        if (!interiorCanBeMine) out.interiorProbability = 0.0;
+        else if (!interiorCanBeSafe) out.interiorProbability = 1.0;
+        else out.interiorProbability = interiorMines / (total * interiorSize);
+    }
+
+    for (size_t c = 0; c < count; c++) {
+        const Component &component = components[order[c].second];
+        const ComponentCounts &cs = component.counts;
+        std::vector<double> others = convolve(prefix[c], suffix[c + 1]);
+        const std::vector<int> &vars = component.vars;
+        for (size_t i = 0; i < vars.size(); i++) {
+            double mass = 0.0;
+            bool canBeSafe = false, canBeMine = false;
+            for (size_t k = 0; k < dist[c].size(); k++) {
+                if (cs.solutions[k] == 0.0) continue;
+                double factor = 0.0;
+                for (size_t m = 0; m < others.size() && m + k < interiorWeight.size(); m++) {
+                    factor += others[m] * interiorWeight[m + k];
+                }
+                if (factor <= 0.0) continue;
+                // Contagens brutas (inteiras) decidem as casas garantidas sem erro de arredondamento.
+                if (cs.mineCounts[k][i] > 0.0) canBeMine = true;
+                if (cs.mineCounts[k][i] < cs.solutions[k]) canBeSafe = true;
+                mass += cs.mineCounts[k][i] / scale[c] * factor;
+            }
+            double &p = flatProbability[vars[i]];
+            if (!canBeMine) p = 0.0;
+            else if (!canBeSafe) p = 1.0;
+            else p = mass / total;
+        }
+    }
+    out.mineProbability.resize(frontierSize);
+    for (int i = 0; i < frontierSize; i++) out.mineProbability[i] = flatProbability[out.frontier[i]];
+    return true;
+}
+
+bool solveFrontier(const Game &game, FrontierSolution &out, long long nodeBudget) {
+    FrontierSolver solver;
+    return solver.solve(game, out, nodeBudget);
+}
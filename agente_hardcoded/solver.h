@@ -0,0 +1,153 @@
+/**
+ * @file solver.h
+ * @brief Resolvedor exato de restrições da fronteira para o agente hardcoded.
+ * @details Cada casa revelada com vizinhos ocultos é uma restrição: entre seus vizinhos
+ * ocultos há exatamente (número - bandeiras) minas. As casas ocultas que aparecem em alguma
+ * restrição formam a fronteira; as demais ocultas formam o "interior", sobre o qual nada se
+ * sabe além do total de minas restantes.
+ *
+ * A fronteira é dividida em componentes independentes (casas ligadas por restrições em
+ * comum). Cada componente é enumerado por backtracking com poda: a cada casa atribuída,
+ * toda restrição que a contém é checada parcialmente (minas já colocadas <= exigidas e
+ * minas colocadas + casas livres >= exigidas). Para cada componente guarda-se, por número
+ * de minas k, quantas soluções existem e quantas delas têm mina em cada casa. Os
+ * componentes são então combinados por convolução, ponderando cada total m de minas na
+ * fronteira por C(interior, minas restantes - m), o que dá a probabilidade exata de cada
+ * casa oculta do tabuleiro ser uma mina.
+ *
+ * O FrontierSolver guarda esse trabalho entre as chamadas de uma mesma partida. As
+ * restrições, a fronteira e os componentes ficam em vetores indexados por Game::index e são
+ * atualizados apenas em volta das casas que mudaram desde a última chamada (reveladas,
+ * marcadas ou desmarcadas). Um componente cujas restrições não mudaram reaproveita a
+ * enumeração anterior; só os componentes tocados pelas mudanças são enumerados de novo.
+ */
+
+#ifndef CAMPO_MINADO_SOLVER_H
+#define CAMPO_MINADO_SOLVER_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "../comum/game.h"
+
+/**
+ * @struct FrontierSolution
+ * @brief Probabilidades exatas de mina calculadas pelo solveFrontier.
+ */
+struct FrontierSolution {
+    std::vector<int> frontier;             // Índices (Game::index) das casas da fronteira, em ordem crescente.
+    std::vector<double> mineProbability;   // P(mina) de cada casa da fronteira, na mesma ordem.
+    std::vector<int> interior;             // Índices das casas ocultas fora da fronteira.
+    double interiorProbability = 0.0;      // P(mina) de qualquer casa do interior.
+    int components = 0;                    // Número de componentes independentes da fronteira.
+    int componentsEnumerated = 0;          // Quantos deles foram enumerados nesta chamada (os demais vieram do cache).
+};
+
+/**
+ * @struct ComponentCounts
+ * @brief Resultado da enumeração de um componente, por número k de minas no componente.
+ */
+struct ComponentCounts {
+    std::vector<double> solutions;                // [k]: soluções com k minas no componente.
+    std::vector<std::vector<double>> mineCounts;  // [k][casa]: dessas, quantas têm mina na casa.
+};
+
+/**
+ * @struct SearchBudget
+ * @brief Limite de trabalho do backtracking: número de nós e, opcionalmente, um prazo.
+ * @details O relógio só é consultado a cada 4096 nós, para não pesar na busca.
+ */
+struct SearchBudget {
+    long long nodesLeft = 0;
+    bool timed = false;
+    std::chrono::steady_clock::time_point deadline;
+
+    /** @brief Consome um nó; false se o orçamento (nós ou prazo) se esgotou. */
+    bool spend() {
+        if (--nodesLeft < 0) return false;
+        if (timed && (nodesLeft & 4095) == 0 && std::chrono::steady_clock::now() > deadline) {
+            nodesLeft = -1;
+            return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * @class FrontierSolver
+ * @brief Resolvedor incremental: mantém restrições, fronteira e componentes de uma chamada para a outra.
+ * @details Pode ser usado com qualquer sequência de tabuleiros (inclusive partidas novas ou
+ * de outro tamanho): cada chamada compara o tabuleiro com o da chamada anterior e atualiza
+ * só o que mudou. Não é thread-safe; use um por thread.
+ */
+class FrontierSolver {
+public:
+    /**
+     * @brief Calcula a probabilidade exata de mina de todas as casas ocultas.
+     * @param game O estado atual do jogo (não é alterado).
+     * @param out Recebe a fronteira (em ordem de índice), o interior e as probabilidades.
+     * @param nodeBudget Número máximo de nós do backtracking nos componentes enumerados nesta chamada.
+     * @param timeBudgetSeconds Prazo da enumeração (0: sem limite de tempo).
+     * @return false se não há casas ocultas, se o tabuleiro é inconsistente (ex: bandeira errada)
+     * ou se o orçamento (nós ou tempo) se esgotou antes de enumerar todos os componentes.
+     */
+    bool solve(const Game &game, FrontierSolution &out, long long nodeBudget = 20000000, double timeBudgetSeconds = 0.0);
+
+    /** @brief Esquece tudo; a próxima chamada reconstrói o estado do zero. */
+    void reset();
+
+private:
+    /**
+     * @struct Component
+     * @brief Casas da fronteira ligadas por restrições, com a enumeração guardada.
+     */
+    struct Component {
+        std::vector<int> vars;        // Casas, na ordem da busca em largura (ordem do backtracking).
+        std::vector<int> constraints; // Casas reveladas cujas restrições formam o componente.
+        ComponentCounts counts;
+        int enumeratedMaxMines = -1;  // Limite de minas da enumeração guardada (-1: não enumerado).
+        bool alive = false;
+    };
+
+    void resize(const Game &game);
+    bool enumerate(const Game &game, Component &component, int maxMines, SearchBudget &budget);
+    void sync(const Game &game);
+    void updateConstraint(const Game &game, int idx);
+    void dissolve(int id);
+    void rebuildComponents(const Game &game);
+    int newComponent();
+
+    int width = -1;
+    int height = -1;
+    std::vector<uint8_t> inside;        // A casa está dentro do tabuleiro (não é borda).
+    std::vector<uint8_t> seen;          // Estado e número de cada casa na última chamada (ver cellCode).
+    std::vector<uint8_t> varMask;       // Vizinhos ocultos de cada restrição ativa (bit i = neighborOffsets[i]).
+    std::vector<int> need;              // Minas que faltam em volta de cada restrição ativa.
+    std::vector<uint8_t> degree;        // Restrições ativas vizinhas de cada casa oculta (> 0: fronteira).
+    std::vector<int> componentOf;       // Componente de cada casa da fronteira (-1: nenhum).
+    std::vector<Component> components;
+    std::vector<int> freeComponents;
+    int inconsistent = 0;               // Restrições impossíveis (need < 0 ou > casas ocultas).
+
+    // Auxiliares reaproveitados entre as chamadas.
+    std::vector<int> changed;
+    std::vector<int> seeds;
+    std::vector<int> stamp;
+    int stampValue = 0;
+    std::vector<int> localIndex;           // Posição de cada casa no seu componente.
+    std::vector<double> flatProbability;   // P(mina) por Game::index, antes de ir para `out`.
+};
+
+/**
+ * @brief Calcula a probabilidade exata de mina de todas as casas ocultas, sem estado entre chamadas.
+ * @details Equivale a um FrontierSolver novo a cada chamada.
+ * @param game O estado atual do jogo (não é alterado).
+ * @param out Recebe a fronteira, o interior e as probabilidades.
+ * @param nodeBudget Número máximo de nós do backtracking (somando todos os componentes).
+ * @return false se não há casas ocultas, se o tabuleiro é inconsistente (ex: bandeira errada)
+ * ou se o orçamento de nós se esgotou antes de enumerar todos os componentes.
+ */
+bool solveFrontier(const Game &game, FrontierSolution &out, long long nodeBudget = 20000000);
+
+#endif // CAMPO_MINADO_SOLVER_H
@@ -0,0 +1,61 @@
+/**
+ * @file bench_board.cpp
+ * @brief Benchmarks do tabuleiro: inicialização a partir de um cenário, cópia de estado e flood fill.
+ */
+
+#include "bench_inputs.h"
+
+namespace {
+
+/** @brief initializeGridFixed com a abertura a partir do ponto de partida, cenário a cenário. */
+void BM_InitializeGridFixed(benchmark::State &state) {
+    const ScenarioSet &set = scenarioSet(boardArgs(state));
+    Game game(set.board.width, set.board.height, set.board.numMines);
+    size_t i = 0;
+    for (auto _ : state) {
+        const Scenario scenario = set.bank.scenario(i);
+        game.initializeGridFixed(scenario.startX, scenario.startY, scenario.mineBits);
+        benchmark::DoNotOptimize(game.revealedSafe);
+        i = (i + 1) % set.bank.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InitializeGridFixed)->Apply(boardSizes);
+
+/** @brief Game::loadState: o custo fixo de começar cada partida de avaliação. */
+void BM_LoadState(benchmark::State &state) {
+    const ScenarioSet &set = scenarioSet(boardArgs(state));
+    Game game(set.board.width, set.board.height, set.board.numMines);
+    size_t i = 0;
+    for (auto _ : state) {
+        game.loadState(set.startBoards[i]);
+        benchmark::ClobberMemory();
+        i = (i + 1) % set.startBoards.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoadState)->Apply(boardSizes);
+
+/**
+ * @brief revealCell no ponto de partida de um tabuleiro sem nada revelado.
+ * @details O ponto de partida não tem minas em volta, então toda jogada abre uma região pelo
+ * flood fill. Inclui o loadState do tabuleiro fechado (ver BM_LoadState).
+ */
+void BM_RevealFloodFill(benchmark::State &state) {
+    const ScenarioSet &set = scenarioSet(boardArgs(state));
+    Game game(set.board.width, set.board.height, set.board.numMines);
+    size_t i = 0;
+    int64_t opened = 0;
+    for (auto _ : state) {
+        const Scenario scenario = set.bank.scenario(i);
+        game.loadState(set.closedBoards[i]);
+        game.revealCell(scenario.startX, scenario.startY);
+        opened += game.revealedSafe;
+        i = (i + 1) % set.bank.size();
+    }
+    state.SetItemsProcessed(opened);
+    state.counters["cells"] = benchmark::Counter(static_cast<double>(opened), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_RevealFloodFill)->Apply(boardSizes);
+
+} // namespace
@@ -0,0 +1,74 @@
+/**
+ * @file bench_files.cpp
+ * @brief Benchmarks da leitura dos arquivos do treinamento: banco de cenários e save da população.
+ */
+
+#include "bench_inputs.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "../agente_genetico/evolution.h"
+#include "../agente_genetico/population_file.h"
+#include "../comum/rng.h"
+
+namespace {
+
+// Cenários do banco aberto por BM_ScenarioBankOpen.
+constexpr uint64_t BANK_SCENARIOS = 10000;
+
+/**
+ * @brief ScenarioBank::open de um banco com BANK_SCENARIOS cenários (mmap, cabeçalho e checksum).
+ * @details O arquivo fica no cache de páginas depois da primeira iteração; mede-se a
+ * validação, não o disco.
+ */
+void BM_ScenarioBankOpen(benchmark::State &state) {
+    const BoardConfig board = boardArgs(state);
+    const std::string path = tempPath("open_" + std::to_string(board.width) + "x" + std::to_string(board.height) + ".dat");
+    if (!ScenarioBank::generate(path, board, BANK_SCENARIOS, BENCH_SEED)) {
+        state.SkipWithError("erro ao gerar o banco");
+        return;
+    }
+    ScenarioBank bank;
+    for (auto _ : state) {
+        if (!bank.open(path, board)) {
+            state.SkipWithError("erro ao abrir o banco");
+            break;
+        }
+        benchmark::DoNotOptimize(bank.scenario(bank.size() - 1).mineBits);
+        bank.close();
+    }
+    std::remove(path.c_str());
+    state.SetBytesProcessed(state.iterations() * BANK_SCENARIOS * (4 + (board.width * board.height + 7) / 8));
+}
+BENCHMARK(BM_ScenarioBankOpen)->Apply(boardSizes)->Unit(benchmark::kMicrosecond);
+
+/** @brief loadPopulation de um save com a população e o genoma padrão do treinamento (300 x 150). */
+void BM_LoadPopulation(benchmark::State &state) {
+    const int populationSize = static_cast<int>(state.range(0));
+    const int numRules = static_cast<int>(state.range(1));
+    const std::string path = tempPath("populacao.dat");
+    {
+        Xoshiro256 rng(deriveSeed(BENCH_SEED, {7}));
+        std::vector<Individual> population;
+        for (int i = 0; i < populationSize; i++) population.push_back(createRandomIndividual(numRules, rng));
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!writePopulation(out, population, 1)) {
+            state.SkipWithError("erro ao gravar a populacao");
+            return;
+        }
+    }
+    std::vector<Individual> population;
+    for (auto _ : state) {
+        if (!loadPopulation(population, path, populationSize, numRules)) {
+            state.SkipWithError("erro ao ler a populacao");
+            break;
+        }
+        benchmark::DoNotOptimize(population.data());
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * populationSize);
+}
+BENCHMARK(BM_LoadPopulation)->ArgNames({"population", "rules"})->Args({300, 150})->Args({3000, 150})->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,131 @@
+/**
+ * @file bench_genetic.cpp
+ * @brief Benchmarks do agente genético: motor de regras, avaliação e operadores genéticos.
+ */
+
+#include "bench_inputs.h"
+
+#include "../agente_genetico/evolution.h"
+#include "../agente_genetico/lockstep_sim.h"
+#include "../comum/rng.h"
+
+namespace {
+
+// Regras por genoma, como no treinamento (--rules).
+constexpr int BENCH_RULES = 150;
+
+// Indivíduos avaliados por cenário: uma passada completa do simulador em lote.
+constexpr int BENCH_INDIVIDUALS = LockstepSimulator::LANES;
+
+/** @brief Registra números de regras por genoma. */
+void ruleCounts(benchmark::internal::Benchmark *bench) {
+    bench->ArgName("rules")->Arg(50)->Arg(BENCH_RULES)->Arg(500);
+}
+
+/**
+ * @brief Uma passada de applyRules do genoma clássico sobre o tabuleiro inicial de cada cenário.
+ * @details Inclui o loadState que recoloca o tabuleiro no início (ver BM_LoadState).
+ */
+void BM_ApplyRules(benchmark::State &state) {
+    const ScenarioSet &set = scenarioSet(boardArgs(state));
+    const Individual ind = classicIndividual(BENCH_RULES);
+    Game game(set.board.width, set.board.height, set.board.numMines);
+    size_t i = 0;
+    for (auto _ : state) {
+        game.loadState(set.startBoards[i]);
+        benchmark::DoNotOptimize(applyRules(ind, game));
+        i = (i + 1) % set.startBoards.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ApplyRules)->Apply(boardSizes);
+
+/** @brief evaluateIndividual de BENCH_INDIVIDUALS indivíduos em todos os cenários, um por vez. */
+void BM_EvaluateIndividual(benchmark::State &state) {
+    const ScenarioSet &set = scenarioSet(boardArgs(state));
+    const std::vector<Individual> population = convergedPopulation(BENCH_INDIVIDUALS, BENCH_RULES);
+    Game game(set.board.width, set.board.height, set.board.numMines);
+    int wins = 0;
+    for (auto _ : state) {
+        for (const Individual &ind : population) {
+            benchmark::DoNotOptimize(evaluateIndividual(ind, set.startBoards, set.seeds, game, wins));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * population.size() * set.startBoards.size());
+    state.counters["win_rate"] = static_cast<double>(wins) / (state.iterations() * population.size() * set.startBoards.size());
+}
+BENCHMARK(BM_EvaluateIndividual)->Apply(boardSizes)->Unit(benchmark::kMillisecond);
+
+/** @brief As mesmas partidas de BM_EvaluateIndividual, jogadas pelo simulador em lote. */
+void BM_LockstepEvaluate(benchmark::State &state) {
+    const ScenarioSet &set = scenarioSet(boardArgs(state));
+    const std::vector<Individual> population = convergedPopulation(BENCH_INDIVIDUALS, BENCH_RULES);
+    std::vector<const RuleProgram *> programs;
+    for (const Individual &ind : population) programs.push_back(&ind.program);
+    LockstepSimulator simulator(set.board.width, set.board.height, set.board.numMines);
+    LaneResult results[LockstepSimulator::LANES];
+    for (auto _ : state) {
+        for (size_t g = 0; g < set.startBoards.size(); g++) {
+            simulator.load(set.startBoards[g], set.seeds[g], programs.data(), static_cast<int>(programs.size()));
+            simulator.play(results);
+            benchmark::DoNotOptimize(results[0].revealedSafe);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * population.size() * set.startBoards.size());
+}
+BENCHMARK(BM_LockstepEvaluate)->Apply(boardSizes)->Unit(benchmark::kMillisecond);
+
+/** @brief crossover entre dois genomas aleatórios. */
+void BM_Crossover(benchmark::State &state) {
+    const int numRules = static_cast<int>(state.range(0));
+    Xoshiro256 rng(deriveSeed(BENCH_SEED, {3, static_cast<uint64_t>(numRules)}));
+    const Individual p1 = createRandomIndividual(numRules, rng);
+    const Individual p2 = createRandomIndividual(numRules, rng);
+    Individual o1, o2;
+    for (auto _ : state) {
+        crossover(p1, p2, o1, o2, rng);
+        benchmark::DoNotOptimize(o1.genome.data());
+        benchmark::DoNotOptimize(o2.genome.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Crossover)->Apply(ruleCounts);
+
+/** @brief mutate com a taxa padrão do treinamento (0.02). */
+void BM_Mutate(benchmark::State &state) {
+    const int numRules = static_cast<int>(state.range(0));
+    Xoshiro256 rng(deriveSeed(BENCH_SEED, {4, static_cast<uint64_t>(numRules)}));
+    Individual ind = createRandomIndividual(numRules, rng);
+    for (auto _ : state) {
+        mutate(ind, 0.02, rng);
+        benchmark::DoNotOptimize(ind.genome.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Mutate)->Apply(ruleCounts);
+
+/** @brief compileRules, executado uma vez por filho em cada geração. */
+void BM_CompileRules(benchmark::State &state) {
+    const int numRules = static_cast<int>(state.range(0));
+    Xoshiro256 rng(deriveSeed(BENCH_SEED, {5, static_cast<uint64_t>(numRules)}));
+    Individual ind = createRandomIndividual(numRules, rng);
+    for (auto _ : state) {
+        compileRules(ind);
+        benchmark::DoNotOptimize(ind.program.hash);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CompileRules)->Apply(ruleCounts);
+
+/** @brief calculateGeneticDistance entre dois genomas aleatórios. */
+void BM_GeneticDistance(benchmark::State &state) {
+    const int numRules = static_cast<int>(state.range(0));
+    Xoshiro256 rng(deriveSeed(BENCH_SEED, {6, static_cast<uint64_t>(numRules)}));
+    const Individual a = createRandomIndividual(numRules, rng);
+    const Individual b = createRandomIndividual(numRules, rng);
+    for (auto _ : state) benchmark::DoNotOptimize(calculateGeneticDistance(a, b));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GeneticDistance)->Apply(ruleCounts);
+
+} // namespace
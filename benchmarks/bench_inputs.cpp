@@ -0,0 +1,90 @@
+/**
+ * @file bench_inputs.cpp
+ * @brief Geração das entradas compartilhadas pelos microbenchmarks.
+ */
+
+#include "bench_inputs.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "../agente_genetico/evolution.h"
+#include "../comum/rng.h"
+
+void boardSizes(benchmark::internal::Benchmark *bench) {
+    bench->ArgNames({"w", "h", "mines"});
+    bench->Args({9, 9, 10});
+    bench->Args({16, 16, 40});
+    bench->Args({30, 16, 99});
+}
+
+BoardConfig boardArgs(const benchmark::State &state) {
+    return {static_cast<int>(state.range(0)), static_cast<int>(state.range(1)), static_cast<int>(state.range(2))};
+}
+
+std::string tempPath(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / ("campo_minado_bench_" + name)).string();
+}
+
+ScenarioSet::~ScenarioSet() {
+    bank.close();
+    std::remove(path.c_str());
+}
+
+const ScenarioSet &scenarioSet(const BoardConfig &board) {
+    // Um conjunto por tamanho, criado na primeira vez que um benchmark o pede.
+    static std::map<std::tuple<int, int, int>, std::unique_ptr<ScenarioSet>> sets;
+    auto &slot = sets[std::make_tuple(board.width, board.height, board.numMines)];
+    if (slot) return *slot;
+
+    slot.reset(new ScenarioSet());
+    ScenarioSet &set = *slot;
+    set.board = board;
+    set.path = tempPath(std::to_string(board.width) + "x" + std::to_string(board.height) + "_" + std::to_string(board.numMines) + ".dat");
+    if (!ScenarioBank::generate(set.path, board, BENCH_SCENARIOS, BENCH_SEED) || !set.bank.open(set.path, board)) {
+        std::cerr << "Erro ao preparar os cenarios do benchmark em " << set.path << "." << std::endl;
+        std::exit(1);
+    }
+    for (size_t i = 0; i < set.bank.size(); i++) {
+        const Scenario scenario = set.bank.scenario(i);
+        set.startBoards.emplace_back(board.width, board.height, board.numMines);
+        set.startBoards.back().initializeGridFixed(scenario.startX, scenario.startY, scenario.mineBits);
+        set.closedBoards.emplace_back(board.width, board.height, board.numMines);
+        set.closedBoards.back().initializeGridFixed(-1, -1, scenario.mineBits);
+        set.seeds.push_back(deriveSeed(BENCH_SEED, {i}));
+    }
+    return set;
+}
+
+Individual classicIndividual(int numRules) {
+    std::vector<Rule> classic;
+    for (int number = 1; number <= 8; number++) {
+        // Marca: uma oculta e faltando uma mina.
+        classic.push_back({number, 1, number - 1, false, false, 1, 5, ACTION_PLACE_FLAG});
+        // Revela: todas as minas já marcadas.
+        for (int hidden = 1; hidden <= 8 - number; hidden++) {
+            classic.push_back({number, hidden, number, false, false, 1, 5, ACTION_REVEAL_HIDDEN});
+        }
+    }
+
+    // O resto do genoma é aleatório, como nos indivíduos do treinamento.
+    Xoshiro256 rng(deriveSeed(BENCH_SEED, {1, static_cast<uint64_t>(numRules)}));
+    Individual ind = createRandomIndividual(numRules, rng);
+    for (int i = 0; i < numRules && i < static_cast<int>(classic.size()); i++) ind.genome[i] = packRule(classic[i]);
+    compileRules(ind);
+    return ind;
+}
+
+std::vector<Individual> convergedPopulation(int count, int numRules) {
+    std::vector<Individual> population(count, classicIndividual(numRules));
+    Xoshiro256 rng(deriveSeed(BENCH_SEED, {2, static_cast<uint64_t>(count), static_cast<uint64_t>(numRules)}));
+    for (int i = 1; i < count; i++) {
+        mutate(population[i], 0.02, rng);
+        compileRules(population[i]);
+    }
+    return population;
+}
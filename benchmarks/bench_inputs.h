@@ -0,0 +1,71 @@
+/**
+ * @file bench_inputs.h
+ * @brief Entradas reprodutíveis dos microbenchmarks: tamanhos de tabuleiro, cenários e genomas.
+ * @details Tudo é derivado de BENCH_SEED, então duas execuções (ou dois commits) medem
+ * exatamente o mesmo trabalho. Os cenários são gerados uma vez por tamanho de tabuleiro com
+ * ScenarioBank::generate, em um arquivo temporário apagado no fim do programa, e abertos
+ * pelo mesmo caminho que o treinamento usa.
+ */
+
+#ifndef CAMPO_MINADO_BENCH_INPUTS_H
+#define CAMPO_MINADO_BENCH_INPUTS_H
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../agente_genetico/rules.h"
+#include "../agente_genetico/scenario_bank.h"
+#include "../comum/config.h"
+#include "../comum/game.h"
+
+// Semente mestra de todas as entradas.
+constexpr uint64_t BENCH_SEED = 20240601;
+
+// Cenários por tamanho de tabuleiro.
+constexpr int BENCH_SCENARIOS = 64;
+
+/** @brief Registra os tamanhos de tabuleiro (iniciante, 16x16 e especialista) como argumentos. */
+void boardSizes(benchmark::internal::Benchmark *bench);
+
+/** @brief O tabuleiro dos argumentos registrados por boardSizes. */
+BoardConfig boardArgs(const benchmark::State &state);
+
+/**
+ * @struct ScenarioSet
+ * @brief Banco de cenários de um tamanho de tabuleiro e os tabuleiros iniciais já abertos.
+ */
+struct ScenarioSet {
+    BoardConfig board;
+    std::string path;                 // Arquivo do banco (temporário).
+    ScenarioBank bank;
+    std::vector<Game> startBoards;    // initializeGridFixed de cada cenário, com a abertura.
+    std::vector<Game> closedBoards;   // Mesmas minas, nada revelado.
+    std::vector<uint64_t> seeds;      // Semente das jogadas aleatórias de cada cenário.
+
+    ~ScenarioSet();
+};
+
+/** @brief Os BENCH_SCENARIOS cenários do tabuleiro, gerados na primeira chamada. */
+const ScenarioSet &scenarioSet(const BoardConfig &board);
+
+/**
+ * @brief Genoma fixo com as duas regras clássicas para cada número e cada contagem.
+ * @details Revela quando as bandeiras completam o número e marca quando resta uma única
+ * oculta para a última mina, em raio 1. Dispara muito mais que um genoma aleatório, como os
+ * genomas das gerações avançadas.
+ */
+Individual classicIndividual(int numRules);
+
+/**
+ * @brief Indivíduos parecidos com os de uma população que já convergiu.
+ * @details O primeiro é classicIndividual; os demais são cópias dele com mutações sorteadas.
+ */
+std::vector<Individual> convergedPopulation(int count, int numRules);
+
+/** @brief Caminho de um arquivo temporário dos benchmarks. */
+std::string tempPath(const std::string &name);
+
+#endif // CAMPO_MINADO_BENCH_INPUTS_H
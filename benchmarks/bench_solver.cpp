@@ -0,0 +1,91 @@
+/**
+ * @file bench_solver.cpp
+ * @brief Benchmarks do resolvedor de restrições do agente hardcoded, por tamanho de fronteira.
+ */
+
+#include "bench_inputs.h"
+
+#include <map>
+#include <random>
+
+#include "../agente_hardcoded/agent.h"
+#include "../agente_hardcoded/solver.h"
+
+namespace {
+
+// Posições guardadas por faixa de fronteira.
+constexpr size_t POSITIONS_PER_SIZE = 8;
+
+/** @brief Casas ocultas vizinhas de pelo menos uma casa revelada do tabuleiro. */
+int frontierSize(const Game &game) {
+    int size = 0;
+    for (int y = 0; y < game.height; y++) {
+        for (int x = 0; x < game.width; x++) {
+            if (game.state(x, y) != HIDDEN) continue;
+            bool frontier = false;
+            for (int dy = -1; dy <= 1 && !frontier; dy++) {
+                for (int dx = -1; dx <= 1 && !frontier; dx++) {
+                    frontier = (dx || dy) && game.inBounds(x + dx, y + dy) && game.state(x + dx, y + dy) == REVEALED;
+                }
+            }
+            size += frontier;
+        }
+    }
+    return size;
+}
+
+/**
+ * @brief Posições de partidas reais do agente com fronteira entre `minSize` e 2 * minSize - 1.
+ * @details As partidas do tabuleiro especialista são jogadas pelo próprio agente a partir de
+ * sementes fixas; cada posição é o tabuleiro antes de um passo do agente.
+ */
+const std::vector<Game> &positions(int minSize) {
+    static std::map<int, std::vector<Game>> cache;
+    std::vector<Game> &found = cache[minSize];
+    if (!found.empty()) return found;
+
+    Game game(30, 16, 99);
+    AgentContext context;
+    StepReport report;
+    for (uint64_t g = 0; g < 2000 && found.size() < POSITIONS_PER_SIZE; g++) {
+        std::mt19937 gen(static_cast<std::mt19937::result_type>(BENCH_SEED + g));
+        game.initializeGrid();
+        game.startGameAt(game.width / 2, game.height / 2, gen);
+        while (!game.gameOver && !game.youWin && found.size() < POSITIONS_PER_SIZE) {
+            const int size = frontierSize(game);
+            if (size >= minSize && size < 2 * minSize) {
+                found.push_back(game);
+                break; // Uma posição por partida, para variar as configurações.
+            }
+            if (!agentStep(game, gen, context, report)) break;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief FrontierSolver::solve a frio (reset antes de cada chamada) em posições com fronteira de range(0)..2*range(0)-1 casas.
+ */
+void BM_FrontierSolve(benchmark::State &state) {
+    const std::vector<Game> &boards = positions(static_cast<int>(state.range(0)));
+    if (boards.empty()) {
+        state.SkipWithError("nenhuma posicao com esse tamanho de fronteira");
+        return;
+    }
+    FrontierSolver solver;
+    FrontierSolution solution;
+    size_t i = 0;
+    int64_t frontier = 0;
+    for (auto _ : state) {
+        solver.reset();
+        benchmark::DoNotOptimize(solver.solve(boards[i], solution));
+        frontier += static_cast<int64_t>(solution.frontier.size());
+        i = (i + 1) % boards.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["frontier"] = benchmark::Counter(static_cast<double>(frontier), benchmark::Counter::kAvgIterations);
+    state.counters["positions"] = static_cast<double>(boards.size());
+}
+BENCHMARK(BM_FrontierSolve)->ArgName("frontier")->RangeMultiplier(2)->Range(4, 64)->Unit(benchmark::kMicrosecond);
+
+} // namespace
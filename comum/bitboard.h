@@ -0,0 +1,82 @@
+/**
+ * @file bitboard.h
+ * @brief Conjuntos de bits de tamanho fixo (64, 128 ou 256 bits) para kernels de restrição.
+ * @details Um Bitboard<W> guarda W palavras de 64 bits. A operação central é countAnd(a, b),
+ * o popcount da interseção de dois conjuntos, usada para checar uma restrição do Campo
+ * Minado de uma só vez: popcount(minas & vizinhos) == número. Com AVX2 disponível
+ * (compilando com -mavx2 ou -march=native), a versão de 256 bits faz o AND e o popcount
+ * em registradores vetoriais; nas demais usa-se o popcount escalar do compilador.
+ */
+
+#ifndef CAMPO_MINADO_BITBOARD_H
+#define CAMPO_MINADO_BITBOARD_H
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @struct Bitboard
+ * @brief Conjunto de até 64 * W elementos, um bit por elemento.
+ */
+template <int W>
+struct Bitboard {
+    static constexpr int BITS = 64 * W;
+
+    alignas(W >= 4 ? 32 : 8) uint64_t words[W] = {};
+
+    void set(int i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+    bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+
+    Bitboard operator&(const Bitboard &o) const {
+        Bitboard r;
+        for (int k = 0; k < W; k++) r.words[k] = words[k] & o.words[k];
+        return r;
+    }
+
+    int count() const {
+        int n = 0;
+        for (int k = 0; k < W; k++) n += __builtin_popcountll(words[k]);
+        return n;
+    }
+
+    /** @brief Chama f(i) para cada bit ligado, em ordem crescente. */
+    template <class F>
+    void forEach(F &&f) const {
+        for (int k = 0; k < W; k++) {
+            for (uint64_t w = words[k]; w != 0; w &= w - 1) f(k * 64 + __builtin_ctzll(w));
+        }
+    }
+};
+
+/** @brief popcount(a & b) sem materializar a interseção. */
+template <int W>
+inline int countAnd(const Bitboard<W> &a, const Bitboard<W> &b) {
+    int n = 0;
+    for (int k = 0; k < W; k++) n += __builtin_popcountll(a.words[k] & b.words[k]);
+    return n;
+}
+
+#if defined(__AVX2__)
+/**
+ * @brief Versão AVX2 para 256 bits: AND vetorial e popcount por tabela de nibbles (vpshufb),
+ * somado por byte com vpsadbw.
+ */
+template <>
+inline int countAnd<4>(const Bitboard<4> &a, const Bitboard<4> &b) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i v = _mm256_and_si256(_mm256_load_si256(reinterpret_cast<const __m256i *>(a.words)),
+                                 _mm256_load_si256(reinterpret_cast<const __m256i *>(b.words)));
+    __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low)),
+                                     _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+    __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+    return static_cast<int>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+                            _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+}
+#endif
+
+#endif // CAMPO_MINADO_BITBOARD_H
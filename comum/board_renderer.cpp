@@ -0,0 +1,245 @@
+/**
+ * @file board_renderer.cpp
+ * @brief Implementação do desenho do tabuleiro com atlas de textos e lotes de retângulos.
+ */
+
+#include "board_renderer.h"
+
+#include <algorithm>
+
+// SDL_RenderGeometry existe a partir do SDL 2.0.18.
+#ifdef SDL_VERSION_ATLEAST
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define CAMPO_MINADO_HAS_RENDER_GEOMETRY 1
+#endif
+#endif
+
+namespace {
+
+// O que uma casa mostra: 0 oculta, 1 bandeira, 2 mina revelada, 3 + n revelada com n minas vizinhas.
+const uint8_t CODE_HIDDEN = 0;
+const uint8_t CODE_FLAG = 1;
+const uint8_t CODE_MINE = 2;
+const uint8_t CODE_REVEALED = 3;
+const uint8_t CODE_NONE = 0xFF; // Casa ainda não desenhada.
+
+// Índices de BoardRenderer::fills.
+enum Fill { FILL_HIDDEN = 0, FILL_REVEALED, FILL_MINE };
+
+uint8_t cellCode(const Game &game, int idx) {
+    switch (game.state(idx)) {
+        case REVEALED: return game.isMine(idx) ? CODE_MINE : static_cast<uint8_t>(CODE_REVEALED + game.neighboringMines(idx));
+        case FLAGGED: return CODE_FLAG;
+        default: return CODE_HIDDEN;
+    }
+}
+
+void setDrawColor(SDL_Renderer* renderer, const SDL_Color &color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+}
+
+/** @brief Retângulo de tamanho `w` x `h` centralizado em `area`. */
+SDL_Rect centered(const SDL_Rect &area, int w, int h) {
+    return SDL_Rect{area.x + (area.w - w) / 2, area.y + (area.h - h) / 2, w, h};
+}
+
+} // namespace
+
+BoardRenderer::BoardRenderer(SDL_Renderer* renderer, TTF_Font* font, const BoardTheme &theme)
+    : renderer(renderer), theme(theme) {
+    buildGlyphs(font);
+}
+
+BoardRenderer::~BoardRenderer() {
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+    } else {
+        for (auto &glyph : glyphs) {
+            if (glyph.texture) SDL_DestroyTexture(glyph.texture);
+        }
+    }
+    if (boardTexture) SDL_DestroyTexture(boardTexture);
+}
+
+void BoardRenderer::buildGlyphs(TTF_Font* font) {
+    SDL_Surface* surfaces[GLYPH_COUNT] = {};
+    for (int g = 0; g < GLYPH_COUNT; g++) {
+        std::string text;
+        SDL_Color color;
+        if (g < GLYPH_FLAG) {
+            text = std::to_string(g + 1);
+            color = theme.digits[g];
+        } else if (g == GLYPH_FLAG) {
+            text = "F";
+            color = theme.flag;
+        } else if (g == GLYPH_LOSE) {
+            text = theme.loseMessage;
+            color = theme.loseText;
+        } else {
+            text = theme.winMessage;
+            color = theme.winText;
+        }
+        surfaces[g] = TTF_RenderText_Solid(font, text.c_str(), color);
+        if (!surfaces[g]) continue;
+        // Um pixel de folga entre os textos evita que a filtragem misture vizinhos no atlas.
+        glyphs[g].src = SDL_Rect{atlasWidth, 0, surfaces[g]->w, surfaces[g]->h};
+        atlasWidth += surfaces[g]->w + 1;
+        atlasHeight = std::max(atlasHeight, surfaces[g]->h);
+    }
+
+    // Junta os textos em uma superfície e sobe uma única textura estática: ao contrário de uma
+    // textura de destino, ela não perde o conteúdo em um SDL_RENDER_TARGETS_RESET. Se não
+    // der, cada texto fica com a sua própria textura.
+    SDL_Surface* sheet = atlasWidth > 0
+        ? SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32) : nullptr;
+    if (sheet) {
+        SDL_FillRect(sheet, nullptr, SDL_MapRGBA(sheet->format, 0, 0, 0, 0));
+        for (int g = 0; g < GLYPH_COUNT; g++) {
+            if (!surfaces[g]) continue;
+            SDL_SetSurfaceBlendMode(surfaces[g], SDL_BLENDMODE_NONE); // O fundo (cor-chave) fica transparente.
+            SDL_Rect dst = glyphs[g].src; // SDL_BlitSurface escreve no retângulo de destino.
+            SDL_BlitSurface(surfaces[g], nullptr, sheet, &dst);
+        }
+        atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+        SDL_FreeSurface(sheet);
+    }
+    if (atlas) SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    for (int g = 0; g < GLYPH_COUNT; g++) {
+        if (!surfaces[g]) continue;
+        if (atlas) {
+            glyphs[g].texture = atlas;
+        } else {
+            glyphs[g].texture = SDL_CreateTextureFromSurface(renderer, surfaces[g]);
+            if (glyphs[g].texture) SDL_SetTextureBlendMode(glyphs[g].texture, SDL_BLENDMODE_BLEND);
+            glyphs[g].src.x = 0;
+        }
+        SDL_FreeSurface(surfaces[g]);
+    }
+}
+
+void BoardRenderer::invalidate() {
+    std::fill(shown.begin(), shown.end(), CODE_NONE);
+}
+
+bool BoardRenderer::prepareBoardTexture(const Game &game) {
+    if (boardTexture && game.width == width && game.height == height) return true;
+    if (boardTextureFailed && game.width == width && game.height == height) return false;
+    if (boardTexture) SDL_DestroyTexture(boardTexture);
+    width = game.width;
+    height = game.height;
+    shown.assign(static_cast<size_t>(width) * height, CODE_NONE);
+    boardTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                     width * theme.cellSize, height * theme.cellSize);
+    boardTextureFailed = boardTexture == nullptr;
+    return boardTexture != nullptr;
+}
+
+void BoardRenderer::draw(const Game &game, int offsetX, int offsetY) {
+    if (prepareBoardTexture(game) && SDL_SetRenderTarget(renderer, boardTexture) == 0) {
+        drawCells(game, 0, 0, true);
+        SDL_SetRenderTarget(renderer, nullptr);
+        SDL_Rect dst = {offsetX, offsetY, width * theme.cellSize, height * theme.cellSize};
+        SDL_RenderCopy(renderer, boardTexture, nullptr, &dst);
+    } else {
+        drawCells(game, offsetX, offsetY, false);
+    }
+    drawMessage(game, offsetX, offsetY);
+}
+
+void BoardRenderer::drawCells(const Game &game, int offsetX, int offsetY, bool onlyChanged) {
+    for (auto &fill : fills) fill.clear();
+    borders.clear();
+    glyphDraws.clear();
+
+    const int cell = theme.cellSize;
+    for (int y = 0; y < game.height; ++y) {
+        for (int x = 0; x < game.width; ++x) {
+            const uint8_t code = cellCode(game, game.index(x, y));
+            uint8_t &last = shown[static_cast<size_t>(y) * width + x];
+            if (onlyChanged && last == code) continue;
+            last = code;
+
+            SDL_Rect cellRect = {offsetX + x * cell, offsetY + y * cell, cell, cell};
+            borders.push_back(cellRect);
+            if (code == CODE_MINE) {
+                fills[FILL_MINE].push_back(cellRect);
+            } else if (code >= CODE_REVEALED) {
+                fills[FILL_REVEALED].push_back(cellRect);
+                if (code > CODE_REVEALED) glyphDraws.push_back({GLYPH_DIGIT_1 + code - CODE_REVEALED - 1, cellRect});
+            } else {
+                fills[FILL_HIDDEN].push_back(cellRect);
+                if (code == CODE_FLAG) glyphDraws.push_back({GLYPH_FLAG, cellRect});
+            }
+        }
+    }
+
+    const SDL_Color fillColors[3] = {theme.hidden, theme.revealed, theme.mine};
+    for (int f = 0; f < 3; f++) {
+        if (fills[f].empty()) continue;
+        setDrawColor(renderer, fillColors[f]);
+        SDL_RenderFillRects(renderer, fills[f].data(), static_cast<int>(fills[f].size()));
+    }
+    // Os textos ficam centralizados nas casas.
+    for (auto &draw : glyphDraws) {
+        const SDL_Rect &src = glyphs[draw.glyph].src;
+        draw.dst = centered(draw.dst, src.w, src.h);
+    }
+    drawGlyphs();
+    if (!borders.empty()) {
+        setDrawColor(renderer, theme.border);
+        SDL_RenderDrawRects(renderer, borders.data(), static_cast<int>(borders.size()));
+    }
+}
+
+void BoardRenderer::drawGlyphs() {
+    if (glyphDraws.empty()) return;
+#ifdef CAMPO_MINADO_HAS_RENDER_GEOMETRY
+    if (atlas) {
+        // Todos os textos saem do atlas: um único lote de quads.
+        const float invW = 1.0f / atlasWidth;
+        const float invH = 1.0f / atlasHeight;
+        const SDL_Color white = {255, 255, 255, 255};
+        vertices.clear();
+        indices.clear();
+        for (const auto &draw : glyphDraws) {
+            const SDL_Rect &src = glyphs[draw.glyph].src;
+            const SDL_Rect &dst = draw.dst;
+            const int base = static_cast<int>(vertices.size());
+            const float x0 = static_cast<float>(dst.x), y0 = static_cast<float>(dst.y);
+            const float x1 = static_cast<float>(dst.x + dst.w), y1 = static_cast<float>(dst.y + dst.h);
+            const float u0 = src.x * invW, v0 = src.y * invH;
+            const float u1 = (src.x + src.w) * invW, v1 = (src.y + src.h) * invH;
+            vertices.push_back({{x0, y0}, white, {u0, v0}});
+            vertices.push_back({{x1, y0}, white, {u1, v0}});
+            vertices.push_back({{x1, y1}, white, {u1, v1}});
+            vertices.push_back({{x0, y1}, white, {u0, v1}});
+            const int quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+        SDL_RenderGeometry(renderer, atlas, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+        return;
+    }
+#endif
+    for (const auto &draw : glyphDraws) {
+        const GlyphImage &glyph = glyphs[draw.glyph];
+        if (glyph.texture) SDL_RenderCopy(renderer, glyph.texture, &glyph.src, &draw.dst);
+    }
+}
+
+void BoardRenderer::drawMessage(const Game &game, int offsetX, int offsetY) {
+    if (!game.gameOver && !game.youWin) return;
+    const SDL_Rect board = {offsetX, offsetY, game.width * theme.cellSize, game.height * theme.cellSize};
+    const SDL_Color &band = game.gameOver ? theme.loseBand : theme.winBand;
+    if (band.a > 0) {
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        setDrawColor(renderer, band);
+        SDL_Rect overlay = {board.x, board.y + board.h / 2 - theme.bandHeight / 2, board.w, theme.bandHeight};
+        SDL_RenderFillRect(renderer, &overlay);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    }
+    glyphDraws.clear();
+    const int glyph = game.gameOver ? GLYPH_LOSE : GLYPH_WIN;
+    glyphDraws.push_back({glyph, centered(board, glyphs[glyph].src.w, glyphs[glyph].src.h)});
+    drawGlyphs();
+}
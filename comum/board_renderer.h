@@ -0,0 +1,126 @@
+/**
+ * @file board_renderer.h
+ * @brief Desenho do tabuleiro com SDL2, compartilhado pelo jogador humano e pelos dois agentes.
+ * @details Os textos (números 1-8, "F" e as mensagens de fim de jogo) são rasterizados uma
+ * única vez, na construção, em um atlas de textura estática, que não perde o conteúdo em um
+ * SDL_RENDER_TARGETS_RESET. A cada quadro:
+ *
+ * - só as casas que mudaram desde o quadro anterior são redesenhadas, em uma textura que
+ *   guarda o tabuleiro entre os quadros;
+ * - os fundos são desenhados com um SDL_RenderFillRects por cor e as bordas com um único
+ *   SDL_RenderDrawRects;
+ * - os textos são copiados do atlas com uma única chamada a SDL_RenderGeometry (SDL 2.0.18
+ *   ou mais novo; nas versões anteriores, um SDL_RenderCopy por texto, ainda sem rasterizar).
+ *
+ * Se o renderer não suportar texturas de destino, o tabuleiro inteiro é desenhado a cada
+ * quadro, com os mesmos lotes.
+ */
+
+#ifndef CAMPO_MINADO_BOARD_RENDERER_H
+#define CAMPO_MINADO_BOARD_RENDERER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "game.h"
+
+/**
+ * @struct BoardTheme
+ * @brief Tamanho das casas, cores e mensagens do tabuleiro.
+ * @details Os valores padrão são os do jogador humano e do agente hardcoded.
+ */
+struct BoardTheme {
+    int cellSize = 30;
+    SDL_Color hidden = {150, 150, 150, 255};   // Casa oculta ou com bandeira.
+    SDL_Color revealed = {200, 200, 200, 255}; // Casa revelada sem mina.
+    SDL_Color mine = {255, 0, 0, 255};         // Mina revelada.
+    SDL_Color border = {0, 0, 0, 255};
+    SDL_Color digits[8] = {{0, 0, 255, 255},   {0, 128, 0, 255},   {255, 0, 0, 255},   {128, 0, 128, 255},
+                           {128, 0, 128, 255}, {128, 0, 128, 255}, {128, 0, 128, 255}, {128, 0, 128, 255}};
+    SDL_Color flag = {255, 0, 0, 255};
+
+    std::string loseMessage = "Voce Perdeu!";
+    std::string winMessage = "Voce Venceu!";
+    SDL_Color loseText = {255, 255, 255, 255};
+    SDL_Color winText = {255, 255, 255, 255};
+    SDL_Color loseBand = {255, 0, 0, 128}; // Faixa atrás da mensagem (alfa 0: sem faixa).
+    SDL_Color winBand = {0, 255, 0, 128};
+    int bandHeight = 60;
+};
+
+/**
+ * @class BoardRenderer
+ * @brief Desenha um Game em um SDL_Renderer, com atlas de textos e redesenho só das casas alteradas.
+ * @details Um BoardRenderer pertence a um único SDL_Renderer e a um único tabuleiro em
+ * exibição; com várias janelas, use um por janela.
+ */
+class BoardRenderer {
+public:
+    /**
+     * @param renderer Renderer de destino (precisa continuar válido enquanto o objeto existir).
+     * @param font Fonte dos textos; só é usada na construção, para montar o atlas.
+     */
+    BoardRenderer(SDL_Renderer* renderer, TTF_Font* font, const BoardTheme &theme = BoardTheme());
+    ~BoardRenderer();
+
+    BoardRenderer(const BoardRenderer &) = delete;
+    BoardRenderer &operator=(const BoardRenderer &) = delete;
+
+    /** @brief Desenha o tabuleiro (e a mensagem de fim de jogo) com o canto superior esquerdo em (offsetX, offsetY). */
+    void draw(const Game &game, int offsetX = 0, int offsetY = 0);
+
+    /** @brief Faz o próximo draw redesenhar todas as casas (ex: depois de perder o conteúdo das texturas). */
+    void invalidate();
+
+private:
+    enum Glyph {
+        GLYPH_DIGIT_1 = 0, // 1 a 8 ocupam os índices 0 a 7.
+        GLYPH_FLAG = 8,
+        GLYPH_LOSE,
+        GLYPH_WIN,
+        GLYPH_COUNT
+    };
+
+    struct GlyphImage {
+        SDL_Texture* texture = nullptr; // O atlas, ou a textura própria do texto se não houver atlas.
+        SDL_Rect src = {0, 0, 0, 0};    // Região do texto na textura.
+    };
+
+    struct GlyphDraw {
+        int glyph;
+        SDL_Rect dst;
+    };
+
+    void buildGlyphs(TTF_Font* font);
+    bool prepareBoardTexture(const Game &game);
+    void drawCells(const Game &game, int offsetX, int offsetY, bool onlyChanged);
+    void drawGlyphs();
+    void drawMessage(const Game &game, int offsetX, int offsetY);
+
+    SDL_Renderer* renderer;
+    BoardTheme theme;
+
+    GlyphImage glyphs[GLYPH_COUNT];
+    SDL_Texture* atlas = nullptr;
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+
+    SDL_Texture* boardTexture = nullptr; // Tabuleiro do último quadro (nullptr: sem texturas de destino).
+    bool boardTextureFailed = false;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> shown; // O que cada casa mostra na boardTexture (ver cellCode em board_renderer.cpp).
+
+    // Lotes do quadro atual, reaproveitados entre os quadros.
+    std::vector<SDL_Rect> fills[3];
+    std::vector<SDL_Rect> borders;
+    std::vector<GlyphDraw> glyphDraws;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+#endif // CAMPO_MINADO_BOARD_RENDERER_H
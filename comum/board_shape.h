@@ -0,0 +1,59 @@
+/**
+ * @file board_shape.h
+ * @brief Geometria do tabuleiro conhecida em tempo de compilação para os tamanhos mais comuns.
+ * @details Os laços mais quentes dos agentes são escritos uma única vez como templates sobre
+ * um "shape". FixedShape<W, H> expõe largura, altura e stride como constantes, o que permite
+ * ao compilador desenrolar e dobrar os cálculos de índice como na época em que as dimensões
+ * eram `const int` globais; DynamicShape cobre qualquer outro tamanho escolhido em tempo de
+ * execução. withBoardShape() escolhe a especialização a partir das dimensões do Game.
+ */
+
+#ifndef CAMPO_MINADO_BOARD_SHAPE_H
+#define CAMPO_MINADO_BOARD_SHAPE_H
+
+#include "game.h"
+
+/**
+ * @struct FixedShape
+ * @brief Dimensões do tabuleiro fixadas em tempo de compilação.
+ */
+template <int W, int H>
+struct FixedShape {
+    static constexpr int width = W;
+    static constexpr int height = H;
+    static constexpr int stride = W + 2 * Game::PADDING;
+
+    static constexpr int index(int x, int y) { return (y + Game::PADDING) * stride + (x + Game::PADDING); }
+    static constexpr bool isNearEdge(int x, int y) { return x <= 1 || x >= W - 2 || y <= 1 || y >= H - 2; }
+};
+
+/**
+ * @struct DynamicShape
+ * @brief Dimensões do tabuleiro lidas do Game em tempo de execução.
+ */
+struct DynamicShape {
+    int width;
+    int height;
+    int stride;
+
+    explicit DynamicShape(const Game &game) : width(game.width), height(game.height), stride(game.stride) {}
+
+    int index(int x, int y) const { return (y + Game::PADDING) * stride + (x + Game::PADDING); }
+    bool isNearEdge(int x, int y) const { return x <= 1 || x >= width - 2 || y <= 1 || y >= height - 2; }
+};
+
+/**
+ * @brief Chama `f(shape)` com a especialização de shape correspondente ao tabuleiro.
+ * @details Tamanhos especializados: 9x9 (iniciante), 10x10 (padrão do projeto),
+ * 16x16 (intermediário) e 30x16 (especialista). Os demais usam DynamicShape.
+ */
+template <class F>
+decltype(auto) withBoardShape(const Game &game, F &&f) {
+    if (game.width == 9 && game.height == 9) return f(FixedShape<9, 9>{});
+    if (game.width == 10 && game.height == 10) return f(FixedShape<10, 10>{});
+    if (game.width == 16 && game.height == 16) return f(FixedShape<16, 16>{});
+    if (game.width == 30 && game.height == 16) return f(FixedShape<30, 16>{});
+    return f(DynamicShape(game));
+}
+
+#endif // CAMPO_MINADO_BOARD_SHAPE_H
@@ -0,0 +1,155 @@
+/**
+ * @file config.cpp
+ * @brief Implementação da leitura de parâmetros em tempo de execução.
+ */
+
+#include "config.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+std::string trim(const std::string &s) {
+    size_t begin = s.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r\n");
+    return s.substr(begin, end - begin + 1);
+}
+
+} // namespace
+
+bool Options::parse(int argc, char* argv[]) {
+    std::map<std::string, std::string> fromArgs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0 || arg.size() == 2) {
+            std::cerr << "Argumento invalido: " << arg << " (use --chave=valor)" << std::endl;
+            return false;
+        }
+        arg = arg.substr(2);
+        size_t eq = arg.find('=');
+        if (eq != std::string::npos) {
+            fromArgs[arg.substr(0, eq)] = arg.substr(eq + 1);
+        } else if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0) {
+            fromArgs[arg] = argv[++i];
+        } else {
+            fromArgs[arg] = "1"; // Flag sem valor, ex: --headless
+        }
+    }
+
+    // O arquivo de configuração é carregado primeiro para que a linha de comando prevaleça.
+    auto config = fromArgs.find("config");
+    if (config != fromArgs.end() && !loadFile(config->second)) return false;
+    for (const auto &kv : fromArgs) values[kv.first] = kv.second;
+    return true;
+}
+
+bool Options::loadFile(const std::string &path) {
+    std::ifstream ifs(path);
+    if (!ifs) {
+        std::cerr << "Erro ao abrir o arquivo de configuracao " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(ifs, line)) {
+        lineNumber++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            std::cerr << path << ":" << lineNumber << ": linha invalida (esperado chave = valor)" << std::endl;
+            return false;
+        }
+        values[trim(line.substr(0, eq))] = trim(line.substr(eq + 1));
+    }
+    return true;
+}
+
+std::string Options::getString(const std::string &key, const std::string &fallback) const {
+    auto it = values.find(key);
+    return it == values.end() ? fallback : it->second;
+}
+
+int Options::getInt(const std::string &key, int fallback) const {
+    auto it = values.find(key);
+    if (it == values.end()) return fallback;
+    char* end = nullptr;
+    errno = 0;
+    long value = std::strtol(it->second.c_str(), &end, 10);
+    if (end == it->second.c_str() || *end != '\0' || errno == ERANGE || value < INT_MIN || value > INT_MAX) {
+        std::cerr << "AVISO: valor invalido para --" << key << " (" << it->second << "). Usando " << fallback << "." << std::endl;
+        return fallback;
+    }
+    return static_cast<int>(value);
+}
+
+long long Options::getInt64(const std::string &key, long long fallback) const {
+    auto it = values.find(key);
+    if (it == values.end()) return fallback;
+    char* end = nullptr;
+    errno = 0;
+    long long value = std::strtoll(it->second.c_str(), &end, 10);
+    if (end == it->second.c_str() || *end != '\0' || errno == ERANGE) {
+        std::cerr << "AVISO: valor invalido para --" << key << " (" << it->second << "). Usando " << fallback << "." << std::endl;
+        return fallback;
+    }
+    return value;
+}
+
+double Options::getDouble(const std::string &key, double fallback) const {
+    auto it = values.find(key);
+    if (it == values.end()) return fallback;
+    char* end = nullptr;
+    double value = std::strtod(it->second.c_str(), &end);
+    if (end == it->second.c_str() || *end != '\0') {
+        std::cerr << "AVISO: valor invalido para --" << key << " (" << it->second << "). Usando " << fallback << "." << std::endl;
+        return fallback;
+    }
+    return value;
+}
+
+bool Options::getBool(const std::string &key, bool fallback) const {
+    auto it = values.find(key);
+    if (it == values.end()) return fallback;
+    const std::string &v = it->second;
+    if (v == "1" || v == "true" || v == "sim" || v == "on") return true;
+    if (v == "0" || v == "false" || v == "nao" || v == "off") return false;
+    std::cerr << "AVISO: valor invalido para --" << key << " (" << v << "). Usando " << fallback << "." << std::endl;
+    return fallback;
+}
+
+bool readBoardConfig(const Options &options, const BoardConfig &defaults, BoardConfig &board) {
+    board = defaults;
+    if (options.has("board")) {
+        std::string preset = options.getString("board", "");
+        if (preset == "beginner") board = {9, 9, 10};
+        else if (preset == "intermediate") board = {16, 16, 40};
+        else if (preset == "expert") board = {30, 16, 99};
+        else {
+            std::cerr << "Tabuleiro desconhecido: " << preset << " (use beginner, intermediate ou expert)" << std::endl;
+            return false;
+        }
+    }
+    board.width = options.getInt("width", board.width);
+    board.height = options.getInt("height", board.height);
+    board.numMines = options.getInt("mines", board.numMines);
+
+    // A área 3x3 do primeiro clique precisa ficar livre de minas; as dimensões são gravadas
+    // em 16 bits no banco de cenários e no registro de partidas.
+    if (board.width < 3 || board.height < 3 || board.width > MAX_BOARD_SIDE || board.height > MAX_BOARD_SIDE) {
+        std::cerr << "O tabuleiro precisa ter entre 3x3 e " << MAX_BOARD_SIDE << "x" << MAX_BOARD_SIDE << " celulas." << std::endl;
+        return false;
+    }
+    const long long maxMines = static_cast<long long>(board.width) * board.height - 9;
+    if (board.numMines < 1 || board.numMines > maxMines) {
+        std::cerr << "Numero de minas invalido para um tabuleiro " << board.width << "x" << board.height
+                  << ": " << board.numMines << " (maximo " << maxMines << ")." << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file config.h
+ * @brief Leitura de parâmetros em tempo de execução (linha de comando e arquivo de configuração).
+ * @details Os parâmetros são pares chave/valor. Na linha de comando eles aparecem como
+ * `--chave=valor` ou `--chave valor`; em um arquivo, como linhas `chave = valor`
+ * (linhas vazias e iniciadas por '#' são ignoradas). `--config=arquivo` carrega um arquivo
+ * antes dos demais argumentos, de forma que a linha de comando sempre tem precedência.
+ */
+
+#ifndef CAMPO_MINADO_CONFIG_H
+#define CAMPO_MINADO_CONFIG_H
+
+#include <map>
+#include <string>
+
+/** @brief Maior largura ou altura aceita (as dimensões são gravadas em 16 bits nos arquivos). */
+constexpr int MAX_BOARD_SIDE = 65535;
+
+/**
+ * @struct BoardConfig
+ * @brief Dimensões e número de minas de um tabuleiro.
+ */
+struct BoardConfig {
+    int width = 10;    // Largura do tabuleiro em células.
+    int height = 10;   // Altura do tabuleiro em células.
+    int numMines = 15; // Número total de minas no tabuleiro.
+};
+
+/**
+ * @struct Options
+ * @brief Conjunto de parâmetros chave/valor lidos da linha de comando e de arquivos.
+ */
+struct Options {
+    std::map<std::string, std::string> values;
+
+    /**
+     * @brief Lê os argumentos da linha de comando.
+     * @return false se algum argumento for inválido (a mensagem de erro já foi impressa).
+     */
+    bool parse(int argc, char* argv[]);
+
+    /**
+     * @brief Lê um arquivo de configuração no formato `chave = valor`.
+     * @return false se o arquivo não puder ser lido ou tiver uma linha inválida.
+     */
+    bool loadFile(const std::string &path);
+
+    bool has(const std::string &key) const { return values.count(key) != 0; }
+
+    // Getters tipados: devolvem `fallback` se a chave não existir ou não puder ser convertida.
+    std::string getString(const std::string &key, const std::string &fallback) const;
+    int getInt(const std::string &key, int fallback) const;
+    long long getInt64(const std::string &key, long long fallback) const;
+    double getDouble(const std::string &key, double fallback) const;
+    bool getBool(const std::string &key, bool fallback) const;
+};
+
+/**
+ * @brief Monta a configuração do tabuleiro a partir das opções.
+ * @details Aceita o preset `board` (beginner 9x9/10, intermediate 16x16/40, expert 30x16/99)
+ * e as chaves `width`, `height` e `mines`, que sobrescrevem o preset.
+ * @param options As opções lidas.
+ * @param defaults Valores usados quando nada é informado.
+ * @param board Saída com a configuração final.
+ * @return false se a configuração for inválida (a mensagem de erro já foi impressa).
+ */
+bool readBoardConfig(const Options &options, const BoardConfig &defaults, BoardConfig &board);
+
+#endif // CAMPO_MINADO_CONFIG_H
@@ -0,0 +1,246 @@
+/**
+ * @file game.cpp
+ * @brief Implementação do motor de tabuleiro compartilhado.
+ */
+
+#include "game.h"
+#include "profiler.h"
+#include "replay_log.h"
+
+#include <algorithm>
+#include <cstring>
+
+Game::Game(int width, int height, int numMines)
+    : width(width), height(height), numMines(numMines), stride(width + 2 * PADDING),
+      cells(static_cast<size_t>(width + 2 * PADDING) * (height + 2 * PADDING)), features(cells.size()) {
+    int k = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) continue;
+            neighborOffsets[k++] = dy * stride + dx;
+        }
+    }
+    k = 0;
+    for (int dy = -2; dy <= 2; ++dy) {
+        for (int dx = -2; dx <= 2; ++dx) {
+            if (dx == 0 && dy == 0) continue;
+            windowOffsets[k++] = dy * stride + dx;
+        }
+    }
+    // Cada célula entra no máximo uma vez na pilha e na lista de alterações.
+    floodStack.reserve(cellCount());
+    changedCells.reserve(cellCount());
+    clearCells();
+}
+
+void Game::clearCells() {
+    // Sentinelas ficam "reveladas": nunca contam como ocultas ou marcadas e param o flood fill.
+    const uint8_t border = static_cast<uint8_t>(BORDER_BIT | (REVEALED << STATE_SHIFT));
+    std::fill(cells.begin(), cells.end(), border);
+    for (int y = 0; y < height; ++y) {
+        uint8_t *row = &cells[index(0, y)];
+        std::fill(row, row + width, static_cast<uint8_t>(HIDDEN << STATE_SHIFT));
+    }
+    resetFeatures();
+    changedCells.clear();
+    hiddenCount = cellCount();
+    revealedSafe = 0;
+    minesRevealed = 0;
+    flagsPlaced = 0;
+    correctFlags = 0;
+}
+
+void Game::resetFeatures() {
+    // Entradas das sentinelas nunca são consultadas; ficam zeradas a cada nova partida.
+    std::fill(features.begin(), features.end(), CellFeatures{});
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int idx = index(x, y);
+            CellFeatures &f = features[idx];
+            if (x <= 1 || x >= width - 2 || y <= 1 || y >= height - 2) f.hiddenMask |= CellFeatures::NEAR_EDGE_BIT;
+            for (int k = 0; k < 24; ++k) {
+                if (state(idx + windowOffsets[k]) == HIDDEN) f.hiddenMask |= 1u << k;
+            }
+            f.hidden1 = static_cast<uint8_t>(__builtin_popcount(f.hiddenMask & CellFeatures::RADIUS1_MASK));
+            f.hidden2 = static_cast<uint8_t>(__builtin_popcount(f.hiddenMask & CellFeatures::RADIUS2_MASK));
+        }
+    }
+}
+
+void Game::setState(int idx, CellState s) {
+    CellState old = state(idx);
+    bool mine = isMine(idx);
+    if (old == HIDDEN) hiddenCount--;
+    else if (old == FLAGGED) { flagsPlaced--; correctFlags -= mine; }
+    else if (old == REVEALED) { if (mine) minesRevealed--; else revealedSafe--; }
+
+    if (s == HIDDEN) hiddenCount++;
+    else if (s == FLAGGED) { flagsPlaced++; correctFlags += mine; }
+    else if (s == REVEALED) { if (mine) minesRevealed++; else revealedSafe++; }
+
+    cells[idx] = static_cast<uint8_t>((cells[idx] & ~STATE_MASK) | (s << STATE_SHIFT));
+
+    // A célula ocupa a posição 23 - k na janela do vizinho idx + windowOffsets[k]
+    // (a janela é simétrica). A borda de PADDING = 2 garante que todos existem.
+    int dHidden = (s == HIDDEN) - (old == HIDDEN);
+    int dFlagged = (s == FLAGGED) - (old == FLAGGED);
+    for (int k = 0; k < 24; ++k) {
+        CellFeatures &f = features[idx + windowOffsets[k]];
+        uint32_t bit = 1u << (23 - k);
+        bool inRadius1 = (CellFeatures::RADIUS1_MASK & bit) != 0;
+        if (dHidden > 0) f.hiddenMask |= bit;
+        else if (dHidden < 0) f.hiddenMask &= ~bit;
+        f.hidden2 = static_cast<uint8_t>(f.hidden2 + dHidden);
+        f.flagged2 = static_cast<uint8_t>(f.flagged2 + dFlagged);
+        if (inRadius1) {
+            f.hidden1 = static_cast<uint8_t>(f.hidden1 + dHidden);
+            f.flagged1 = static_cast<uint8_t>(f.flagged1 + dFlagged);
+        }
+    }
+}
+
+void Game::computeNeighborCounts() {
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int idx = index(x, y);
+            if (isMine(idx)) continue;
+            int count = 0;
+            for (int offset : neighborOffsets) {
+                count += (cells[idx + offset] & MINE_BIT) != 0;
+            }
+            cells[idx] = static_cast<uint8_t>((cells[idx] & ~NUMBER_MASK) | count);
+        }
+    }
+}
+
+void Game::initializeGrid() {
+    gameOver = false;
+    youWin = false;
+    firstMoveMade = false;
+    clearCells();
+}
+
+void Game::startGameAt(int startX, int startY, std::mt19937 &gen) {
+    if (firstMoveMade) return;
+
+    // 1. Posiciona as minas no tabuleiro, evitando a "safe zone" 3x3 inicial.
+    int placedMines = 0;
+    while (placedMines < numMines) {
+        int x = gen() % width;
+        int y = gen() % height;
+        bool isInSafeZone = (x >= startX - 1 && x <= startX + 1 && y >= startY - 1 && y <= startY + 1);
+        int idx = index(x, y);
+        if (!isMine(idx) && !isInSafeZone) {
+            cells[idx] |= MINE_BIT;
+            placedMines++;
+        }
+    }
+
+    // 2. Calcula os números (minas vizinhas) para todas as células do tabuleiro.
+    computeNeighborCounts();
+
+    firstMoveMade = true;
+    // 3. Revela a célula inicial segura.
+    revealCell(startX, startY);
+}
+
+void Game::initializeGridFixed(int startX, int startY, const uint8_t *mineBits) {
+    gameOver = false;
+    youWin = false;
+    clearCells();
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int bit = y * width + x;
+            if (mineBits[bit >> 3] & (1 << (bit & 7))) cells[index(x, y)] |= MINE_BIT;
+        }
+    }
+    computeNeighborCounts();
+    firstMoveMade = true;
+
+    // Revela a célula inicial segura.
+    if (startX >= 0 && startY >= 0) {
+        revealCell(startX, startY);
+    }
+}
+
+void Game::loadState(const Game &start) {
+    std::memcpy(cells.data(), start.cells.data(), cells.size() * sizeof(uint8_t));
+    std::memcpy(features.data(), start.features.data(), features.size() * sizeof(CellFeatures));
+    changedCells.assign(start.changedCells.begin(), start.changedCells.end());
+
+    gameOver = start.gameOver;
+    youWin = start.youWin;
+    firstMoveMade = start.firstMoveMade;
+    hiddenCount = start.hiddenCount;
+    revealedSafe = start.revealedSafe;
+    minesRevealed = start.minesRevealed;
+    flagsPlaced = start.flagsPlaced;
+    correctFlags = start.correctFlags;
+}
+
+void Game::revealCell(int x, int y) {
+    if (!inBounds(x, y)) return;
+    revealIndex(index(x, y));
+}
+
+void Game::revealIndex(int idx) {
+    changedCells.clear();
+    // A borda tem estado REVEALED, então esta única checagem cobre os limites do tabuleiro.
+    if (state(idx) != HIDDEN) return;
+    if (moveLog) moveLog->push_back(encodeMove(cellY(idx) * width + cellX(idx), false));
+    setState(idx, REVEALED);
+    changedCells.push_back(idx);
+    if (isMine(idx)) { gameOver = true; return; }
+
+    // Flood fill iterativo: a célula é marcada como revelada ao ser empilhada, então
+    // nenhuma célula é visitada duas vezes. Vizinhos de um '0' nunca são minas.
+    if (neighboringMines(idx) == 0) {
+        floodStack.push_back(idx);
+        while (!floodStack.empty()) {
+            int current = floodStack.back();
+            floodStack.pop_back();
+            for (int offset : neighborOffsets) {
+                int n = current + offset;
+                if (state(n) != HIDDEN) continue;
+                setState(n, REVEALED);
+                changedCells.push_back(n);
+                if (neighboringMines(n) == 0) floodStack.push_back(n);
+            }
+        }
+        PROFILE_COUNT(FLOOD_CELLS, changedCells.size() - 1);
+    }
+    checkWinCondition();
+}
+
+void Game::placeFlag(int x, int y) {
+    if (!inBounds(x, y)) { changedCells.clear(); return; }
+    placeFlagIndex(index(x, y));
+}
+
+void Game::placeFlagIndex(int idx) {
+    changedCells.clear();
+    if (state(idx) != HIDDEN) return;
+    if (moveLog) moveLog->push_back(encodeMove(cellY(idx) * width + cellX(idx), true));
+    setState(idx, FLAGGED);
+    changedCells.push_back(idx);
+}
+
+void Game::toggleFlag(int x, int y) {
+    changedCells.clear();
+    if (!inBounds(x, y) || !firstMoveMade) return;
+    int idx = index(x, y);
+    if (state(idx) == HIDDEN) {
+        setState(idx, FLAGGED);
+        changedCells.push_back(idx);
+    } else if (state(idx) == FLAGGED) {
+        setState(idx, HIDDEN);
+        changedCells.push_back(idx);
+    }
+}
+
+void Game::checkWinCondition() {
+    if (revealedSafe == cellCount() - numMines) {
+        youWin = true;
+    }
+}
@@ -0,0 +1,209 @@
+/**
+ * @file game.h
+ * @brief Motor de tabuleiro compartilhado pelos três módulos do Campo Minado.
+ * @details O tabuleiro é armazenado em um único vetor contíguo com um byte por célula e
+ * uma borda de sentinelas ao redor da área jogável. A borda permite varrer vizinhanças
+ * 3x3 e 5x5 sem nenhuma verificação de limites: as sentinelas nunca são minas e
+ * nunca estão ocultas ou marcadas, então simplesmente não contam.
+ */
+
+#ifndef CAMPO_MINADO_GAME_H
+#define CAMPO_MINADO_GAME_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @enum CellState
+ * @brief Define os possíveis estados de uma célula no tabuleiro.
+ */
+enum CellState : uint8_t {
+    HIDDEN,   // A célula está oculta.
+    REVEALED, // A célula foi revelada.
+    FLAGGED   // A célula foi marcada com uma bandeira.
+};
+
+/**
+ * @struct CellFeatures
+ * @brief Resumo da vizinhança de uma célula, mantido incrementalmente pelo Game.
+ * @details A janela 5x5 ao redor da célula (sem o centro) tem 24 posições, numeradas em
+ * ordem de linha: o bit k de hiddenMask corresponde a Game::windowOffsets[k]. As contagens
+ * de raio 2 incluem as de raio 1. Sentinelas da borda nunca contam como ocultas ou marcadas.
+ */
+struct CellFeatures {
+    uint32_t hiddenMask;     // Bits 0-23: vizinhos ocultos na janela 5x5; bit 24: NEAR_EDGE_BIT.
+    uint8_t hidden1;         // Vizinhos ocultos no raio 1 (3x3).
+    uint8_t flagged1;        // Vizinhos com bandeira no raio 1 (3x3).
+    uint8_t hidden2;         // Vizinhos ocultos no raio 2 (5x5).
+    uint8_t flagged2;        // Vizinhos com bandeira no raio 2 (5x5).
+
+    static constexpr uint32_t NEAR_EDGE_BIT = 1u << 24; // A célula está a até 1 casa da borda.
+    static constexpr uint32_t RADIUS1_MASK = 0x0399C0;  // Bits da janela que pertencem ao raio 1.
+    static constexpr uint32_t RADIUS2_MASK = 0xFFFFFF;  // Todos os bits da janela.
+
+    bool nearEdge() const { return (hiddenMask & NEAR_EDGE_BIT) != 0; }
+};
+
+/**
+ * @struct Game
+ * @brief Gerencia todo o estado e a lógica de uma partida de Campo Minado.
+ * @details Cada célula é um byte: bits 0-3 guardam o número de minas vizinhas, o bit 4
+ * indica mina, os bits 5-6 guardam o CellState e o bit 7 marca as sentinelas da borda.
+ * As células são endereçadas por um índice linear (ver index()); os vizinhos de um índice
+ * são obtidos somando os deslocamentos de neighborOffsets.
+ */
+struct Game {
+    static constexpr int PADDING = 2;            // Largura da borda de sentinelas (cobre o escopo 5x5).
+
+    static constexpr uint8_t NUMBER_MASK = 0x0F; // Número de minas vizinhas (0 a 8).
+    static constexpr uint8_t MINE_BIT = 0x10;    // A célula contém uma mina.
+    static constexpr int STATE_SHIFT = 5;
+    static constexpr uint8_t STATE_MASK = 0x60;  // CellState da célula.
+    static constexpr uint8_t BORDER_BIT = 0x80;  // Sentinela fora da área jogável.
+
+    int width;                   // Largura do tabuleiro em células.
+    int height;                  // Altura do tabuleiro em células.
+    int numMines;                // Número total de minas no tabuleiro.
+    int stride;                  // Distância, em bytes, entre duas linhas consecutivas.
+    std::vector<uint8_t> cells;  // Tabuleiro linear, incluindo a borda de sentinelas.
+    int neighborOffsets[8];      // Deslocamentos de índice para as 8 células vizinhas.
+    int windowOffsets[24];       // Deslocamentos da janela 5x5 (sem o centro), em ordem de linha.
+    std::vector<CellFeatures> features; // Resumo da vizinhança de cada célula, paralelo a `cells`.
+    std::vector<int> changedCells; // Índices das células alteradas pela última ação (revelar/marcar).
+    std::vector<uint32_t> *moveLog = nullptr; // Se não nulo, recebe cada jogada que muda o tabuleiro (ver replay_log.h).
+
+    bool gameOver = false;       // Flag que indica o fim do jogo por derrota.
+    bool youWin = false;         // Flag que indica o fim do jogo por vitória.
+    bool firstMoveMade = false;  // Flag que indica se as minas já foram posicionadas.
+
+    // Contadores mantidos a cada transição de estado, para consultas em O(1).
+    int hiddenCount = 0;         // Células ainda ocultas (sem bandeira).
+    int revealedSafe = 0;        // Células sem mina já reveladas.
+    int minesRevealed = 0;       // Minas reveladas (explosões).
+    int flagsPlaced = 0;         // Bandeiras colocadas.
+    int correctFlags = 0;        // Bandeiras colocadas sobre minas.
+
+    /**
+     * @brief Construtor. Aloca o tabuleiro com as dimensões informadas e o deixa vazio.
+     */
+    Game(int width, int height, int numMines);
+
+    // --- Endereçamento ---
+
+    /** @brief Converte coordenadas (x, y) da área jogável em um índice linear. */
+    int index(int x, int y) const { return (y + PADDING) * stride + (x + PADDING); }
+    /** @brief Coordenada X de um índice linear. */
+    int cellX(int idx) const { return idx % stride - PADDING; }
+    /** @brief Coordenada Y de um índice linear. */
+    int cellY(int idx) const { return idx / stride - PADDING; }
+    /** @brief Verdadeiro se (x, y) está dentro da área jogável. */
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    /** @brief Número de células jogáveis (sem a borda). */
+    int cellCount() const { return width * height; }
+
+    // --- Consulta de células (por índice linear) ---
+
+    bool isMine(int idx) const { return (cells[idx] & MINE_BIT) != 0; }
+    bool isBorder(int idx) const { return (cells[idx] & BORDER_BIT) != 0; }
+    int neighboringMines(int idx) const { return cells[idx] & NUMBER_MASK; }
+    CellState state(int idx) const { return static_cast<CellState>((cells[idx] & STATE_MASK) >> STATE_SHIFT); }
+
+    // --- Consulta de células (por coordenadas) ---
+
+    bool isMine(int x, int y) const { return isMine(index(x, y)); }
+    int neighboringMines(int x, int y) const { return neighboringMines(index(x, y)); }
+    CellState state(int x, int y) const { return state(index(x, y)); }
+
+    // --- Ciclo de vida da partida ---
+
+    /**
+     * @brief Prepara o tabuleiro para um novo jogo, resetando todas as células.
+     */
+    void initializeGrid();
+
+    /**
+     * @brief Inicia o jogo a partir de uma coordenada segura.
+     * @details Posiciona as minas aleatoriamente fora da área 3x3 ao redor do ponto inicial,
+     * calcula os números e revela a célula inicial. Só tem efeito uma vez por partida.
+     * @param startX A coordenada X do ponto de partida.
+     * @param startY A coordenada Y do ponto de partida.
+     * @param gen Gerador de números aleatórios usado no posicionamento das minas.
+     */
+    void startGameAt(int startX, int startY, std::mt19937 &gen);
+
+    /**
+     * @brief Inicializa o tabuleiro com um layout de minas pré-definido.
+     * @param startX Coordenada X do ponto de partida seguro (negativo para não revelar nada).
+     * @param startY Coordenada Y do ponto de partida seguro.
+     * @param mineBits Máscara de minas com um bit por célula, em ordem de linha: o bit
+     * i = y * width + x (bit i % 8 do byte i / 8) indica mina em (x, y).
+     */
+    void initializeGridFixed(int startX, int startY, const uint8_t *mineBits);
+
+    /**
+     * @brief Copia o estado completo de outro tabuleiro com as mesmas dimensões.
+     * @details Células, resumos de vizinhança, contadores e flags são copiados com memcpy
+     * para os buffers já alocados deste tabuleiro, sem recalcular números nem flood fill.
+     * Permite começar várias partidas a partir de um mesmo tabuleiro inicial preparado uma
+     * única vez com initializeGridFixed.
+     * @param start Tabuleiro de origem (mesmos width, height e numMines).
+     */
+    void loadState(const Game &start);
+
+    // --- Ações ---
+
+    /**
+     * @brief Revela uma célula e, se for vazia (0 minas vizinhas), revela sua região vazia.
+     * @details O flood fill é iterativo e usa uma pilha pré-alocada do próprio tabuleiro, sem
+     * recursão e sem alocação por jogada. As células reveladas ficam em changedCells.
+     */
+    void revealCell(int x, int y);
+
+    /**
+     * @brief Versão de revealCell por índice linear. Índices da borda são ignorados.
+     */
+    void revealIndex(int idx);
+
+    /**
+     * @brief Coloca uma bandeira em uma célula oculta.
+     */
+    void placeFlag(int x, int y);
+
+    /**
+     * @brief Versão de placeFlag por índice linear. Índices da borda são ignorados.
+     */
+    void placeFlagIndex(int idx);
+
+    /**
+     * @brief Alterna o estado de uma célula entre oculta e marcada com bandeira.
+     * @details Não tem efeito antes de as minas serem posicionadas.
+     */
+    void toggleFlag(int x, int y);
+
+    /**
+     * @brief Verifica se a condição de vitória foi atingida (todas as células não-minas reveladas).
+     * @details Consulta apenas os contadores, sem percorrer o tabuleiro.
+     */
+    void checkWinCondition();
+
+private:
+    /**
+     * @brief Muda o estado de uma célula jogável e atualiza os contadores e as 24 entradas
+     * de `features` cuja janela contém a célula.
+     */
+    void setState(int idx, CellState s);
+
+    std::vector<int> floodStack; // Pilha de trabalho do flood fill, com capacidade para o tabuleiro inteiro.
+
+    /** @brief Apaga todas as células jogáveis e reconstrói a borda de sentinelas. */
+    void clearCells();
+
+    /** @brief Recalcula `features` do zero (todas as células jogáveis ocultas). */
+    void resetFeatures();
+
+    /** @brief Calcula o número de minas vizinhas de todas as células jogáveis. */
+    void computeNeighborCounts();
+};
+
+#endif // CAMPO_MINADO_GAME_H
@@ -0,0 +1,221 @@
+/**
+ * @file profiler.cpp
+ * @brief Blocos por thread, soma dos totais, log por geração e gravação do trace.
+ */
+
+#include "profiler.h"
+
+#include <iomanip>
+#include <iostream>
+
+#ifdef CAMPO_MINADO_PROFILE
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace profiling {
+
+const char *sectionName(Section section) {
+    switch (section) {
+    case SECTION_EVALUATION: return "evaluation";
+    case SECTION_PARALLEL_CHUNK: return "parallel_chunk";
+    case SECTION_SELECTION: return "selection";
+    case SECTION_CROSSOVER: return "crossover";
+    case SECTION_MUTATION: return "mutation";
+    case SECTION_COMPILATION: return "compilation";
+    case SECTION_CHECKPOINT: return "checkpoint";
+    case SECTION_VISUALIZATION: return "visualization";
+    case SECTION_REPLAY: return "replay";
+    default: return "?";
+    }
+}
+
+const char *counterName(Counter counter) {
+    switch (counter) {
+    case COUNTER_RULE_TESTS: return "rule_tests";
+    case COUNTER_RULE_FIRINGS: return "rule_firings";
+    case COUNTER_RANDOM_MOVES: return "random_moves";
+    case COUNTER_FLOOD_CELLS: return "flood_cells";
+    default: return "?";
+    }
+}
+
+Totals Totals::since(const Totals &earlier) const {
+    Totals delta;
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        delta.sectionNs[s] = sectionNs[s] - earlier.sectionNs[s];
+        delta.sectionCalls[s] = sectionCalls[s] - earlier.sectionCalls[s];
+    }
+    for (int c = 0; c < COUNTER_COUNT; c++) delta.counters[c] = counters[c] - earlier.counters[c];
+    return delta;
+}
+
+bool ProfileLog::open(const std::string &path) {
+    out.open(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Erro ao criar o arquivo de profiling " << path << "." << std::endl;
+        return false;
+    }
+    csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    if (csv) {
+        out << "generation,seconds,games";
+        for (int s = 0; s < SECTION_COUNT; s++) out << ',' << sectionName(static_cast<Section>(s)) << "_ms";
+        for (int c = 0; c < COUNTER_COUNT; c++) out << ',' << counterName(static_cast<Counter>(c));
+        out << '\n';
+    }
+    return true;
+}
+
+void ProfileLog::write(int generation, double seconds, int games, const Totals &delta) {
+    out << std::fixed << std::setprecision(3);
+    if (csv) {
+        out << generation << ',' << seconds << ',' << games;
+        for (int s = 0; s < SECTION_COUNT; s++) out << ',' << delta.sectionNs[s] / 1e6;
+        for (int c = 0; c < COUNTER_COUNT; c++) out << ',' << delta.counters[c];
+    } else {
+        out << "{\"generation\":" << generation << ",\"seconds\":" << seconds << ",\"games\":" << games;
+        for (int s = 0; s < SECTION_COUNT; s++) out << ",\"" << sectionName(static_cast<Section>(s)) << "_ms\":" << delta.sectionNs[s] / 1e6;
+        for (int c = 0; c < COUNTER_COUNT; c++) out << ",\"" << counterName(static_cast<Counter>(c)) << "\":" << delta.counters[c];
+        out << '}';
+    }
+    out << std::endl;
+}
+
+#ifdef CAMPO_MINADO_PROFILE
+
+namespace {
+
+/** @brief Um escopo cronometrado com o trace ligado. */
+struct TraceEvent {
+    Section section;
+    uint64_t startNs;
+    uint64_t durationNs;
+};
+
+/**
+ * @struct ThreadBlock
+ * @brief Tempos, contadores e eventos de uma thread.
+ * @details Só a própria thread escreve nos contadores (load + store relaxados, sem RMW);
+ * totals() os lê de outras threads. Os blocos nunca são liberados, então continuam
+ * legíveis depois que a thread termina.
+ */
+struct ThreadBlock {
+    std::atomic<uint64_t> sectionNs[SECTION_COUNT] = {};
+    std::atomic<uint64_t> sectionCalls[SECTION_COUNT] = {};
+    std::atomic<uint64_t> counters[COUNTER_COUNT] = {};
+    int id = 0;
+    std::string name;
+    std::mutex eventsMutex; // Sem disputa, exceto durante writeTrace.
+    std::vector<TraceEvent> events;
+};
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBlock>> registry;
+std::atomic<bool> tracing{false};
+const auto epoch = std::chrono::steady_clock::now();
+
+ThreadBlock &threadBlock() {
+    thread_local ThreadBlock *block = [] {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.emplace_back(new ThreadBlock());
+        registry.back()->id = static_cast<int>(registry.size());
+        registry.back()->name = "thread " + std::to_string(registry.size());
+        return registry.back().get();
+    }();
+    return *block;
+}
+
+inline void add(std::atomic<uint64_t> &value, uint64_t n) {
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+} // namespace
+
+void count(Counter counter, uint64_t n) { add(threadBlock().counters[counter], n); }
+
+void setThreadName(const char *name) {
+    ThreadBlock &block = threadBlock();
+    std::lock_guard<std::mutex> lock(block.eventsMutex);
+    block.name = name;
+}
+
+ScopedTimer::ScopedTimer(Section section) : section(section), start(nowNs()) {}
+
+ScopedTimer::~ScopedTimer() {
+    const uint64_t duration = nowNs() - start;
+    ThreadBlock &block = threadBlock();
+    add(block.sectionNs[section], duration);
+    add(block.sectionCalls[section], 1);
+    if (tracing.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(block.eventsMutex);
+        block.events.push_back({section, start, duration});
+    }
+}
+
+Totals totals() {
+    Totals sum;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto &block : registry) {
+        for (int s = 0; s < SECTION_COUNT; s++) {
+            sum.sectionNs[s] += block->sectionNs[s].load(std::memory_order_relaxed);
+            sum.sectionCalls[s] += block->sectionCalls[s].load(std::memory_order_relaxed);
+        }
+        for (int c = 0; c < COUNTER_COUNT; c++) sum.counters[c] += block->counters[c].load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+void startTrace() { tracing.store(true, std::memory_order_relaxed); }
+
+void stopTrace() { tracing.store(false, std::memory_order_relaxed); }
+
+bool writeTrace(const std::string &path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Erro ao criar o arquivo de trace " << path << "." << std::endl;
+        return false;
+    }
+    // Formato de eventos do Chrome: "M" nomeia as threads, "X" é um escopo completo (tempos em µs).
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    for (const auto &block : registry) {
+        std::lock_guard<std::mutex> lock(block->eventsMutex);
+        out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << block->id
+            << ",\"args\":{\"name\":\"" << block->name << "\"}}";
+        first = false;
+        for (const TraceEvent &event : block->events) {
+            out << ",\n{\"name\":\"" << sectionName(event.section) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << block->id
+                << ",\"ts\":" << event.startNs / 1000 << '.' << std::setw(3) << std::setfill('0') << event.startNs % 1000
+                << ",\"dur\":" << event.durationNs / 1000 << '.' << std::setw(3) << std::setfill('0') << event.durationNs % 1000 << '}';
+        }
+    }
+    out << "\n]}\n";
+    out.close();
+    if (!out) {
+        std::cerr << "Erro ao gravar o arquivo de trace " << path << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#else // !CAMPO_MINADO_PROFILE
+
+Totals totals() { return Totals(); }
+
+void startTrace() {}
+
+void stopTrace() {}
+
+bool writeTrace(const std::string &) { return true; }
+
+#endif // CAMPO_MINADO_PROFILE
+
+} // namespace profiling
@@ -0,0 +1,160 @@
+/**
+ * @file profiler.h
+ * @brief Instrumentação de baixo custo: cronômetros por escopo, contadores e trace do Chrome.
+ * @details Tudo que fica no caminho quente (PROFILE_SCOPE, PROFILE_COUNT, PROFILE_THREAD)
+ * só existe quando o programa é compilado com `-DCAMPO_MINADO_PROFILE`; sem a flag, as
+ * macros não geram código nenhum. O resto da API (totals(), ProfileLog, writeTrace) existe
+ * sempre, para que quem a usa não precise de #ifdef; sem a flag, os totais ficam zerados.
+ *
+ * Cada thread acumula seus tempos e contadores em um bloco próprio, sem locks e sem
+ * operações atômicas de leitura-modificação-escrita (só loads e stores relaxados, que no x86
+ * são movs comuns). totals() soma os blocos de todas as threads que já usaram a
+ * instrumentação; a diferença entre dois totais dá o registro de uma geração.
+ *
+ * Com o trace ligado (startTrace), cada escopo cronometrado também vira um evento "X" do
+ * formato de trace do Chrome (chrome://tracing ou https://ui.perfetto.dev), com uma linha por
+ * thread nomeada por PROFILE_THREAD.
+ */
+
+#ifndef CAMPO_MINADO_PROFILER_H
+#define CAMPO_MINADO_PROFILER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace profiling {
+
+#ifdef CAMPO_MINADO_PROFILE
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+/**
+ * @enum Section
+ * @brief Trechos cronometrados. O tempo de um trecho é a soma em todas as threads.
+ */
+enum Section {
+    SECTION_EVALUATION,     // Avaliação da população inteira (thread do treinamento).
+    SECTION_PARALLEL_CHUNK, // Blocos de um parallelFor, em cada worker do pool.
+    SECTION_SELECTION,      // Torneios da seleção.
+    SECTION_CROSSOVER,      // Crossover (ou cópia) dos genomas dos filhos.
+    SECTION_MUTATION,       // Mutação dos filhos.
+    SECTION_COMPILATION,    // Compilação dos programas de regras dos filhos.
+    SECTION_CHECKPOINT,     // Serialização da população e gravação do save.
+    SECTION_VISUALIZATION,  // Entrega à visualização e quadros desenhados pela thread dela.
+    SECTION_REPLAY,         // Partidas do melhor indivíduo gravadas no log de replay.
+    SECTION_COUNT
+};
+
+/**
+ * @enum Counter
+ * @brief Eventos contados no caminho quente.
+ */
+enum Counter {
+    COUNTER_RULE_TESTS,     // Regras cujas condições foram comparadas com uma casa.
+    COUNTER_RULE_FIRINGS,   // Regras cujas condições bateram (a ação foi executada).
+    COUNTER_RANDOM_MOVES,   // Jogadas aleatórias (revealRandomCell) por falta de regra.
+    COUNTER_FLOOD_CELLS,    // Casas reveladas pelo flood fill além da casa clicada.
+    COUNTER_COUNT
+};
+
+/** @brief Nome curto do trecho (usado nas colunas do log e nos eventos do trace). */
+const char *sectionName(Section section);
+
+/** @brief Nome curto do contador. */
+const char *counterName(Counter counter);
+
+/**
+ * @struct Totals
+ * @brief Tempos e contadores acumulados (desde o início, ou entre dois instantes).
+ */
+struct Totals {
+    uint64_t sectionNs[SECTION_COUNT] = {};
+    uint64_t sectionCalls[SECTION_COUNT] = {};
+    uint64_t counters[COUNTER_COUNT] = {};
+
+    /** @brief Diferença campo a campo (this - earlier). */
+    Totals since(const Totals &earlier) const;
+};
+
+/** @brief Soma dos blocos de todas as threads (zeros sem CAMPO_MINADO_PROFILE). */
+Totals totals();
+
+/** @brief Passa a gravar um evento de trace por escopo cronometrado. */
+void startTrace();
+
+/** @brief Para de gravar eventos (os já gravados continuam disponíveis para writeTrace). */
+void stopTrace();
+
+/**
+ * @brief Grava os eventos coletados no formato JSON de trace do Chrome.
+ * @return false se o arquivo não puder ser escrito (a mensagem de erro já foi impressa).
+ */
+bool writeTrace(const std::string &path);
+
+/**
+ * @class ProfileLog
+ * @brief Um registro legível por máquina por geração: CSV (arquivo terminado em .csv) ou JSON lines.
+ * @details Colunas: generation, seconds, games, um `<trecho>_ms` por Section e um por Counter.
+ */
+class ProfileLog {
+public:
+    /** @return false se o arquivo não puder ser criado (a mensagem de erro já foi impressa). */
+    bool open(const std::string &path);
+
+    bool isOpen() const { return out.is_open(); }
+
+    /** @brief Escreve o registro de uma geração e força a gravação. */
+    void write(int generation, double seconds, int games, const Totals &delta);
+
+private:
+    std::ofstream out;
+    bool csv = false;
+};
+
+#ifdef CAMPO_MINADO_PROFILE
+
+/** @brief Soma `n` ao contador na thread atual. */
+void count(Counter counter, uint64_t n);
+
+/** @brief Dá nome à linha da thread atual no trace. */
+void setThreadName(const char *name);
+
+/**
+ * @class ScopedTimer
+ * @brief Cronometra o escopo em que é declarado (use pela macro PROFILE_SCOPE).
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Section section);
+    ~ScopedTimer();
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    Section section;
+    uint64_t start;
+};
+
+#endif // CAMPO_MINADO_PROFILE
+
+} // namespace profiling
+
+#ifdef CAMPO_MINADO_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+/** @brief Cronometra o resto do escopo atual no trecho profiling::SECTION_<section>. */
+#define PROFILE_SCOPE(section) profiling::ScopedTimer PROFILE_CONCAT(profileScope, __LINE__)(profiling::SECTION_##section)
+/** @brief Soma `n` ao contador profiling::COUNTER_<counter>. */
+#define PROFILE_COUNT(counter, n) profiling::count(profiling::COUNTER_##counter, static_cast<uint64_t>(n))
+/** @brief Nomeia a thread atual no trace. */
+#define PROFILE_THREAD(name) profiling::setThreadName(name)
+#else
+#define PROFILE_SCOPE(section) ((void)0)
+#define PROFILE_COUNT(counter, n) ((void)sizeof(n)) // Não avalia `n`, mas conta como uso.
+#define PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif // CAMPO_MINADO_PROFILER_H
@@ -0,0 +1,266 @@
+/**
+ * @file replay_log.cpp
+ * @brief Codificação, gravação e leitura do registro de partidas.
+ */
+
+#include "replay_log.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+constexpr char MAGIC[8] = {'C', 'M', 'R', 'E', 'P', 'L', 'A', 'Y'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_BYTES = 24;
+
+size_t mineBytes(const BoardConfig &board) { return (static_cast<size_t>(board.width) * board.height + 7) / 8; }
+
+void putVarint(std::vector<char> &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+template <class T>
+void putRaw(std::vector<char> &out, const T &value) {
+    const char *bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void encodeHeader(const BoardConfig &board, std::vector<char> &out) {
+    out.insert(out.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    putRaw(out, VERSION);
+    putRaw(out, static_cast<uint16_t>(board.width));
+    putRaw(out, static_cast<uint16_t>(board.height));
+    putRaw(out, static_cast<uint32_t>(board.numMines));
+    putRaw(out, uint32_t(0));
+}
+
+/**
+ * @struct Cursor
+ * @brief Leitura sequencial de um trecho de bytes; `ok` fica falso na primeira leitura além do fim.
+ */
+struct Cursor {
+    const uint8_t *data;
+    size_t pos;
+    size_t end;
+    bool ok = true;
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos >= end) break;
+            const uint8_t byte = data[pos++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        ok = false;
+        return 0;
+    }
+
+    /** @brief Varint que precisa caber em um int não negativo; senão `ok` fica falso. */
+    int nonNegative() {
+        const uint64_t value = varint();
+        if (value > static_cast<uint64_t>(INT_MAX)) {
+            ok = false;
+            return 0;
+        }
+        return static_cast<int>(value);
+    }
+
+    template <class T>
+    T raw() {
+        T value{};
+        if (pos + sizeof(T) > end) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+};
+
+/**
+ * @brief Percorre os registros depois do cabeçalho, chamando `visit(início, fim)` para cada
+ * corpo completo.
+ * @return A posição logo após o último registro completo (igual a `size` se nenhum estiver
+ * cortado).
+ */
+template <class Visit>
+size_t scanRecords(const uint8_t *data, size_t size, Visit visit) {
+    Cursor cursor{data, HEADER_BYTES, size};
+    size_t complete = HEADER_BYTES;
+    while (cursor.pos < cursor.end) {
+        const uint64_t bodySize = cursor.varint();
+        if (!cursor.ok || bodySize > cursor.end - cursor.pos) break;
+        visit(cursor.pos, cursor.pos + bodySize);
+        cursor.pos += bodySize;
+        complete = cursor.pos;
+    }
+    return complete;
+}
+
+} // namespace
+
+void replayStart(const ReplayGame &replay, Game &game) {
+    game.initializeGridFixed(replay.startX, replay.startY, replay.mineBits.data());
+}
+
+void replayMove(uint32_t move, Game &game) {
+    const int cell = moveCell(move);
+    const int idx = game.index(cell % game.width, cell / game.width);
+    if (moveIsFlag(move)) {
+        game.placeFlagIndex(idx);
+    } else {
+        game.revealIndex(idx);
+    }
+}
+
+void replaySeek(const ReplayGame &replay, size_t moves, Game &game) {
+    replayStart(replay, game);
+    const size_t count = std::min(moves, replay.moves.size());
+    for (size_t i = 0; i < count; i++) replayMove(replay.moves[i], game);
+}
+
+bool ReplayWriter::open(const std::string &filename, const BoardConfig &boardConfig) {
+    board = boardConfig;
+    path = filename;
+    buffer.clear();
+
+    std::ifstream existing(path, std::ios::binary);
+    std::vector<uint8_t> contents;
+    if (existing) contents.assign(std::istreambuf_iterator<char>(existing), std::istreambuf_iterator<char>());
+    existing.close();
+    const bool hasHeader = contents.size() >= HEADER_BYTES;
+    if (hasHeader) {
+        std::vector<char> expected;
+        encodeHeader(board, expected);
+        if (std::memcmp(contents.data(), expected.data(), HEADER_BYTES) != 0) {
+            std::cerr << "Erro: '" << path << "' nao e um registro de partidas deste tabuleiro (ou e de outra versao)." << std::endl;
+            return false;
+        }
+        // Uma execução interrompida no meio de uma gravação deixa um registro cortado no fim;
+        // as novas partidas não podem ser acrescentadas depois dele.
+        const size_t complete = scanRecords(contents.data(), contents.size(), [](size_t, size_t) {});
+        if (complete < contents.size()) {
+            std::error_code error;
+            std::filesystem::resize_file(path, complete, error);
+            if (error) {
+                std::cerr << "Erro ao descartar a partida incompleta no fim de '" << path << "': " << error.message() << std::endl;
+                return false;
+            }
+            std::cerr << "AVISO: O registro '" << path << "' terminava no meio de uma partida; ela foi descartada." << std::endl;
+        }
+    } else {
+        encodeHeader(board, buffer);
+    }
+
+    // Um arquivo sem cabeçalho completo é recomeçado do zero.
+    out.open(path, std::ios::binary | (hasHeader ? std::ios::app : std::ios::trunc));
+    if (!out) {
+        std::cerr << "Erro ao abrir o registro de partidas '" << path << "'." << std::endl;
+        return false;
+    }
+    return flush();
+}
+
+void ReplayWriter::append(const ReplayGame &replay) {
+    std::vector<char> body;
+    putVarint(body, static_cast<uint64_t>(replay.generation));
+    putVarint(body, static_cast<uint64_t>(replay.scenario));
+    putVarint(body, static_cast<uint64_t>(replay.startX));
+    putVarint(body, static_cast<uint64_t>(replay.startY));
+    body.push_back(replay.won ? 1 : 0);
+    putRaw(body, replay.score);
+    body.insert(body.end(), replay.mineBits.begin(), replay.mineBits.begin() + mineBytes(board));
+    putVarint(body, replay.moves.size());
+    for (uint32_t move : replay.moves) putVarint(body, move);
+
+    putVarint(buffer, body.size());
+    buffer.insert(buffer.end(), body.begin(), body.end());
+}
+
+bool ReplayWriter::flush() {
+    if (buffer.empty()) return true;
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    buffer.clear();
+    if (!out) {
+        std::cerr << "Erro ao gravar o registro de partidas '" << path << "'." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ReplayReader::open(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Erro ao abrir o registro de partidas '" << path << "'." << std::endl;
+        return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    offsets.clear();
+    ends.clear();
+
+    Cursor header{contents.data(), sizeof(MAGIC), contents.size()};
+    if (contents.size() < HEADER_BYTES || std::memcmp(contents.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Erro: '" << path << "' nao e um registro de partidas." << std::endl;
+        return false;
+    }
+    const uint32_t version = header.raw<uint32_t>();
+    boardConfig.width = header.raw<uint16_t>();
+    boardConfig.height = header.raw<uint16_t>();
+    boardConfig.numMines = static_cast<int>(header.raw<uint32_t>());
+    if (version != VERSION) {
+        std::cerr << "Erro: o registro '" << path << "' esta na versao " << version << "; este programa le a versao " << VERSION << "." << std::endl;
+        return false;
+    }
+    if (boardConfig.width < 1 || boardConfig.height < 1) {
+        std::cerr << "Erro: o registro '" << path << "' tem um tabuleiro invalido." << std::endl;
+        return false;
+    }
+
+    // Só os tamanhos são lidos aqui; cada partida é decodificada quando pedida.
+    const size_t complete = scanRecords(contents.data(), contents.size(), [&](size_t begin, size_t end) {
+        offsets.push_back(begin);
+        ends.push_back(end);
+    });
+    if (complete < contents.size()) {
+        std::cerr << "AVISO: O registro '" << path << "' termina no meio de uma partida; ela foi ignorada." << std::endl;
+    }
+    return true;
+}
+
+bool ReplayReader::read(size_t index, ReplayGame &out) const {
+    Cursor in{contents.data(), offsets[index], ends[index]};
+    out.generation = in.nonNegative();
+    out.scenario = in.nonNegative();
+    out.startX = in.nonNegative();
+    out.startY = in.nonNegative();
+    out.won = in.raw<uint8_t>() != 0;
+    out.score = in.raw<double>();
+
+    const size_t bytes = mineBytes(boardConfig);
+    if (!in.ok || in.pos + bytes > in.end) return false;
+    out.mineBits.assign(contents.begin() + in.pos, contents.begin() + in.pos + bytes);
+    in.pos += bytes;
+
+    const uint64_t count = in.varint();
+    if (!in.ok || count > in.end - in.pos) return false; // Cada jogada ocupa ao menos um byte.
+    out.moves.resize(count);
+    for (uint64_t i = 0; i < count; i++) {
+        const uint64_t move = in.varint();
+        if (move > UINT32_MAX || moveCell(static_cast<uint32_t>(move)) >= boardConfig.width * boardConfig.height) in.ok = false;
+        out.moves[i] = static_cast<uint32_t>(move);
+    }
+    return in.ok && in.pos == in.end && out.startX >= 0 && out.startX < boardConfig.width
+        && out.startY >= 0 && out.startY < boardConfig.height;
+}
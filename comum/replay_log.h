@@ -0,0 +1,125 @@
+/**
+ * @file replay_log.h
+ * @brief Registro compacto das jogadas de partidas, para revê-las sem simular o agente de novo.
+ * @details Formato (versão 1, little-endian):
+ * - cabeçalho de 24 bytes: assinatura "CMREPLAY", versão (uint32), largura e altura (uint16),
+ *   minas (uint32) e um uint32 reservado;
+ * - uma sequência de partidas, cada uma com o tamanho do resto do registro (varint), geração,
+ *   cenário, startX e startY (varints), vitória (1 byte), pontuação (double), a máscara de
+ *   minas (um bit por célula, como no banco de cenários), o número de jogadas e as jogadas.
+ *
+ * Cada jogada é um varint com a célula (y * largura + x) e a ação no bit baixo (ver
+ * encodeMove): em um tabuleiro 10x10 quase todas ocupam 1 ou 2 bytes. Só as jogadas que
+ * mudaram o tabuleiro são gravadas; as casas abertas pelo flood fill vêm da própria jogada.
+ * Como o registro guarda a máscara de minas e o ponto de partida, ele não depende do banco de
+ * cenários: rever ou comparar partidas custa só a leitura do arquivo e as jogadas no Game.
+ */
+
+#ifndef CAMPO_MINADO_REPLAY_LOG_H
+#define CAMPO_MINADO_REPLAY_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "game.h"
+
+/** @brief Codifica uma jogada: célula jogável (y * largura + x) e se é uma bandeira. */
+inline uint32_t encodeMove(int cell, bool flag) { return static_cast<uint32_t>(cell) << 1 | (flag ? 1u : 0u); }
+/** @brief Célula jogável (y * largura + x) de uma jogada. */
+inline int moveCell(uint32_t move) { return static_cast<int>(move >> 1); }
+/** @brief Verdadeiro se a jogada coloca uma bandeira (senão, revela a célula). */
+inline bool moveIsFlag(uint32_t move) { return (move & 1u) != 0; }
+
+/**
+ * @struct ReplayGame
+ * @brief Uma partida gravada: o cenário, o resultado e as jogadas efetivas, em ordem.
+ */
+struct ReplayGame {
+    int generation = 0;             // Geração em que a partida foi jogada.
+    int scenario = 0;               // Índice do cenário no banco.
+    int startX = 0;                 // Ponto de partida seguro.
+    int startY = 0;
+    bool won = false;
+    double score = 0.0;             // Pontuação da partida (ver scoreScenario).
+    std::vector<uint8_t> mineBits;  // Máscara de minas (bit y * largura + x).
+    std::vector<uint32_t> moves;    // Jogadas codificadas por encodeMove.
+};
+
+/**
+ * @brief Prepara `game` no início da partida: minas do registro e ponto de partida revelado.
+ * @details `game` precisa ter as dimensões do arquivo do registro.
+ */
+void replayStart(const ReplayGame &replay, Game &game);
+
+/** @brief Aplica uma jogada gravada ao tabuleiro. */
+void replayMove(uint32_t move, Game &game);
+
+/**
+ * @brief Coloca `game` no estado da partida depois das `moves` primeiras jogadas.
+ * @details Recomeça do tabuleiro inicial e aplica as jogadas, sem avaliar nenhuma regra.
+ */
+void replaySeek(const ReplayGame &replay, size_t moves, Game &game);
+
+/**
+ * @class ReplayWriter
+ * @brief Acrescenta partidas a um arquivo de registro.
+ */
+class ReplayWriter {
+public:
+    /**
+     * @brief Abre `path` para acrescentar partidas, criando o arquivo se ele não existir.
+     * @return false se o arquivo não puder ser aberto ou for de outro tabuleiro (a mensagem já foi impressa).
+     */
+    bool open(const std::string &path, const BoardConfig &board);
+
+    /** @brief Acrescenta uma partida; só chega ao disco no próximo flush. */
+    void append(const ReplayGame &replay);
+
+    /** @brief Grava as partidas acrescentadas desde o último flush. @return false em caso de erro de escrita. */
+    bool flush();
+
+    bool isOpen() const { return out.is_open(); }
+
+private:
+    BoardConfig board;
+    std::ofstream out;
+    std::string path;
+    std::vector<char> buffer; // Partidas codificadas ainda não gravadas.
+};
+
+/**
+ * @class ReplayReader
+ * @brief Arquivo de registro carregado na memória, com acesso direto a cada partida.
+ */
+class ReplayReader {
+public:
+    /**
+     * @brief Lê `path` e indexa as partidas (o índice só percorre os tamanhos dos registros).
+     * @return false se o arquivo não existir ou não for um registro válido (a mensagem já foi impressa).
+     */
+    bool open(const std::string &path);
+
+    /** @brief Dimensões e minas do tabuleiro das partidas. */
+    const BoardConfig &board() const { return boardConfig; }
+
+    /** @brief Número de partidas no arquivo. */
+    size_t size() const { return offsets.size(); }
+
+    /**
+     * @brief Decodifica a partida `index` em `out`.
+     * @return false se o registro estiver corrompido.
+     */
+    bool read(size_t index, ReplayGame &out) const;
+
+private:
+    BoardConfig boardConfig;
+    std::vector<uint8_t> contents;
+    std::vector<size_t> offsets; // Início do corpo de cada partida em `contents`.
+    std::vector<size_t> ends;    // Fim do corpo de cada partida.
+};
+
+#endif // CAMPO_MINADO_REPLAY_LOG_H
@@ -0,0 +1,108 @@
+/**
+ * @file rng.h
+ * @brief Geradores pseudoaleatórios rápidos e derivação de fluxos independentes a partir de uma semente.
+ * @details O treinamento usa uma única semente mestra. Cada fluxo de números (a seleção dos
+ * cenários de uma geração, a reprodução de uma geração, as jogadas aleatórias em um cenário,
+ * ...) recebe sua própria semente, derivada da mestra e de um caminho de identificadores com
+ * deriveSeed. Como a semente de um fluxo depende só desse caminho, e não da ordem em que as
+ * threads pedem números, uma execução com a mesma semente é reproduzível bit a bit com
+ * qualquer número de threads, e nenhuma thread compartilha estado de gerador com outra.
+ *
+ * O gerador é o xoshiro256** (Blackman e Vigna): 32 bytes de estado, poucas instruções por
+ * número e qualidade estatística suficiente para simulação. Ele satisfaz os requisitos de
+ * UniformRandomBitGenerator, então funciona com as distribuições de <random>.
+ */
+
+#ifndef CAMPO_MINADO_RNG_H
+#define CAMPO_MINADO_RNG_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+/**
+ * @brief Um passo do SplitMix64: avança `state` e devolve um valor de 64 bits bem misturado.
+ * @details Usado para expandir sementes; valores de entrada próximos (0, 1, 2, ...) dão
+ * saídas sem correlação aparente.
+ */
+inline uint64_t splitMix64(uint64_t &state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Deriva a semente de um fluxo a partir da semente mestra e de um caminho de identificadores.
+ * @details Ex: deriveSeed(seed, {STREAM_EVALUATION, scenarioIndex}). Caminhos diferentes dão
+ * sementes independentes; o mesmo caminho dá sempre a mesma semente.
+ */
+inline uint64_t deriveSeed(uint64_t seed, std::initializer_list<uint64_t> path) {
+    uint64_t state = seed;
+    uint64_t derived = splitMix64(state);
+    for (uint64_t id : path) {
+        state = derived ^ id;
+        derived = splitMix64(state);
+    }
+    return derived;
+}
+
+/**
+ * @class Xoshiro256
+ * @brief Gerador xoshiro256** de 64 bits.
+ */
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    /** @brief Inicializa os 4 words de estado expandindo `seed` com SplitMix64. */
+    explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) {
+        for (uint64_t &word : s) word = splitMix64(seed);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Inteiro uniforme em [0, n), com n > 0 (método de Lemire: produto de 128 bits e rejeição).
+     * @details Dá a mesma sequência que std::uniform_int_distribution da libstdc++ (GCC 11 ou
+     * mais novo) com este gerador, mas não depende da implementação da biblioteca padrão: o
+     * kernel de GPU do agente genético (gpu_eval.h) repete exatamente este cálculo.
+     */
+    uint64_t below(uint64_t n) {
+        uint128 product = static_cast<uint128>((*this)()) * n;
+        uint64_t low = static_cast<uint64_t>(product);
+        if (low < n) {
+            const uint64_t threshold = -n % n;
+            while (low < threshold) {
+                product = static_cast<uint128>((*this)()) * n;
+                low = static_cast<uint64_t>(product);
+            }
+        }
+        return static_cast<uint64_t>(product >> 64);
+    }
+
+private:
+    // Extensão do GCC/Clang; o __extension__ mantém o cabeçalho limpo com -Wpedantic.
+    __extension__ typedef unsigned __int128 uint128;
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s[4];
+};
+
+#endif // CAMPO_MINADO_RNG_H
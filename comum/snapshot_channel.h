@@ -0,0 +1,61 @@
+/**
+ * @file snapshot_channel.h
+ * @brief Canal sem locks de uma thread produtora para uma consumidora, que entrega sempre o valor mais recente.
+ * @details É um buffer triplo: o produtor escreve em um buffer só dele, o consumidor lê de
+ * outro buffer só dele e o terceiro fica no meio, trocado atomicamente por quem terminou
+ * sua parte. Nenhum dos dois lados espera pelo outro. Se o produtor publicar várias vezes
+ * antes de o consumidor ler, os valores intermediários são descartados: o consumidor só vê o
+ * último. Como os buffers são reaproveitados, depois das primeiras publicações a cópia para
+ * o buffer de escrita não aloca memória (os vetores mantêm sua capacidade).
+ *
+ * Só pode haver uma thread produtora e uma consumidora. Usado entre o treinamento e a
+ * visualização do agente genético e entre o agente hardcoded e a sua janela.
+ */
+
+#ifndef CAMPO_MINADO_SNAPSHOT_CHANNEL_H
+#define CAMPO_MINADO_SNAPSHOT_CHANNEL_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class SnapshotChannel
+ * @brief Buffer triplo "último valor vence" entre duas threads.
+ */
+template <typename T>
+class SnapshotChannel {
+public:
+    /** @brief Buffer em que o produtor monta o próximo valor (só o produtor o usa). */
+    T &writeBuffer() { return buffers[writeIndex]; }
+
+    /** @brief Entrega o valor montado em writeBuffer() e passa a escrever em outro buffer. */
+    void publish() {
+        const uint8_t previous = middle.exchange(static_cast<uint8_t>(writeIndex | FRESH), std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Troca o buffer de leitura pelo valor mais recente, se houver um valor novo.
+     * @return true se readBuffer() passou a conter um valor ainda não consumido.
+     */
+    bool consume() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        const uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /** @brief Último valor consumido (só o consumidor o usa). */
+    const T &readBuffer() const { return buffers[readIndex]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4; // O buffer do meio tem um valor ainda não consumido.
+
+    T buffers[3];
+    uint8_t writeIndex = 0;
+    uint8_t readIndex = 1;
+    std::atomic<uint8_t> middle{2};
+};
+
+#endif // CAMPO_MINADO_SNAPSHOT_CHANNEL_H
@@ -0,0 +1,75 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementação do pool fixo de threads.
+ */
+
+#include "thread_pool.h"
+
+#include <string>
+
+#include "profiler.h"
+
+ThreadPool::ThreadPool(int numThreads) {
+    if (numThreads <= 0) numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (numThreads <= 0) numThreads = 1;
+    threads.reserve(numThreads - 1);
+    for (int worker = 1; worker < numThreads; ++worker) {
+        threads.emplace_back([this, worker]() { workerLoop(worker); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    startCv.notify_all();
+    for (auto &t : threads) t.join();
+}
+
+void ThreadPool::run(const std::function<void(int, int, int)> &chunk, int count, int chunkSize) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        job = &chunk;
+        jobCount = count;
+        jobChunk = chunkSize;
+        nextIndex.store(0, std::memory_order_relaxed);
+        busyWorkers = static_cast<int>(threads.size());
+        epoch++;
+    }
+    startCv.notify_all();
+
+    processChunks(0); // A thread chamadora também trabalha.
+
+    std::unique_lock<std::mutex> lock(mtx);
+    doneCv.wait(lock, [this]() { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::processChunks(int worker) {
+    for (;;) {
+        int begin = nextIndex.fetch_add(jobChunk, std::memory_order_relaxed);
+        if (begin >= jobCount) return;
+        int end = std::min(begin + jobChunk, jobCount);
+        PROFILE_SCOPE(PARALLEL_CHUNK);
+        (*job)(worker, begin, end);
+    }
+}
+
+void ThreadPool::workerLoop(int worker) {
+    PROFILE_THREAD(("worker " + std::to_string(worker)).c_str());
+    uint64_t seenEpoch = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            startCv.wait(lock, [&]() { return stopping || epoch != seenEpoch; });
+            if (stopping) return;
+            seenEpoch = epoch;
+        }
+        processChunks(worker);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (--busyWorkers == 0) doneCv.notify_one();
+        }
+    }
+}
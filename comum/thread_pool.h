@@ -0,0 +1,80 @@
+/**
+ * @file thread_pool.h
+ * @brief Pool fixo de threads para laços paralelos (avaliação de fitness, benchmarks).
+ * @details As threads são criadas uma única vez e reutilizadas por todos os laços. Cada
+ * laço é dividido em blocos de índices que as threads retiram de um contador atômico
+ * compartilhado: quem termina um bloco pega o próximo, então partidas longas e curtas se
+ * equilibram sozinhas sem nenhuma thread ficar ociosa enquanto ainda há trabalho.
+ */
+
+#ifndef CAMPO_MINADO_THREAD_POOL_H
+#define CAMPO_MINADO_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Conjunto persistente de threads que executa laços `parallelFor`.
+ * @details A thread que chama parallelFor também trabalha e é sempre o worker 0; as demais
+ * recebem os ids 1..size()-1. O id permite que cada worker use seus próprios buffers.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Cria o pool.
+     * @param numThreads Número total de workers (incluindo a thread chamadora).
+     * 0 usa todos os núcleos de hardware disponíveis.
+     */
+    explicit ThreadPool(int numThreads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /** @brief Número total de workers, incluindo a thread chamadora. */
+    int size() const { return static_cast<int>(threads.size()) + 1; }
+
+    /**
+     * @brief Executa `body(worker, i)` para todo i em [0, count) e espera o término.
+     * @param count Número de índices.
+     * @param chunkSize Índices retirados por vez; 0 escolhe um valor que gera ~16 blocos por worker.
+     * @param body Função chamada como body(int worker, int index).
+     */
+    template <class F>
+    void parallelFor(int count, int chunkSize, F &&body) {
+        if (count <= 0) return;
+        if (chunkSize <= 0) chunkSize = std::max(1, count / (size() * 16));
+        std::function<void(int, int, int)> chunk = [&body](int worker, int begin, int end) {
+            for (int i = begin; i < end; ++i) body(worker, i);
+        };
+        run(chunk, count, chunkSize);
+    }
+
+private:
+    void run(const std::function<void(int, int, int)> &chunk, int count, int chunkSize);
+    void processChunks(int worker);
+    void workerLoop(int worker);
+
+    std::vector<std::thread> threads;
+    std::mutex mtx;
+    std::condition_variable startCv;
+    std::condition_variable doneCv;
+
+    // Laço em execução (válido enquanto busyWorkers > 0).
+    const std::function<void(int, int, int)> *job = nullptr;
+    int jobCount = 0;
+    int jobChunk = 1;
+    std::atomic<int> nextIndex{0};
+    int busyWorkers = 0;
+    uint64_t epoch = 0;   // Incrementado a cada laço para acordar os workers.
+    bool stopping = false;
+};
+
+#endif // CAMPO_MINADO_THREAD_POOL_H
@@ -2,274 +2,143 @@
  * @file main.cpp
  * @brief Implementação de um jogo Campo Minado jogável por um humano.
  * @details Este programa utiliza a biblioteca SDL2 para criar uma interface gráfica
- * e permite que o usuário jogue Campo Minado com o mouse.
+ * e permite que o usuário jogue Campo Minado com o mouse. Com --replay=arquivo, ele mostra
+ * as partidas de um registro (ver comum/replay_log.h) em vez de um jogo novo.
  */
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <iostream>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <random>
+#include <memory>
+
+#include "../comum/board_renderer.h"
+#include "../comum/config.h"
+#include "../comum/game.h"
+#include "../comum/replay_log.h"
 
 // === Constantes Globais do Jogo ===
+// As dimensões do tabuleiro são lidas em tempo de execução (ver main()).
 const int CELL_SIZE = 30;      // Tamanho de cada célula em pixels
-const int GRID_WIDTH = 10;     // Largura do tabuleiro em células
-const int GRID_HEIGHT = 10;    // Altura do tabuleiro em células
-const int NUM_MINES = 15;      // Número total de minas no tabuleiro
-const int WINDOW_WIDTH = GRID_WIDTH * CELL_SIZE;   // Largura da janela em pixels
-const int WINDOW_HEIGHT = GRID_HEIGHT * CELL_SIZE; // Altura da janela em pixels
+
+const Uint32 IDLE_TIMEOUT_MS = 1000; // Espera máxima por um evento: a janela só acorda com eventos.
+const Uint32 REPLAY_STEP_MS = 150;   // Intervalo entre dois passos da reprodução automática.
+const int REPLAY_FAST_STEPS = 10;    // Jogadas por passo no avanço rápido.
 
 // Gerador de números aleatórios global para o posicionamento das minas
 std::random_device rd_global;
 std::mt19937 gen_global(rd_global());
 
 /**
- * @enum CellState
- * @brief Define os possíveis estados de uma célula no tabuleiro.
+ * @struct ReplayView
+ * @brief Estado do modo replay: a partida e a jogada exibidas e a reprodução automática.
  */
-enum CellState {
-    HIDDEN,   // A célula está oculta.
-    REVEALED, // A célula foi revelada.
-    FLAGGED   // A célula foi marcada com uma bandeira.
+struct ReplayView {
+    ReplayReader reader;
+    ReplayGame current;
+    size_t gameIndex = 0;
+    size_t move = 0;         // Jogadas da partida já aplicadas ao tabuleiro.
+    bool playing = false;
+    int stepMoves = 1;       // Jogadas por passo da reprodução (REPLAY_FAST_STEPS no avanço rápido).
+    Uint32 lastStep = 0;
 };
 
 /**
- * @struct Cell
- * @brief Representa uma única célula do tabuleiro.
+ * @brief Leva o tabuleiro até a jogada `move` da partida atual.
+ * @details Para frente, só as jogadas que faltam são aplicadas; para trás, a partida é
+ * refeita do início (ver replaySeek). Nenhuma regra é avaliada.
  */
-struct Cell {
-    bool isMine = false;             // Verdadeiro se a célula contém uma mina.
-    int neighboringMines = 0;        // Número de minas nas 8 células vizinhas.
-    CellState state = HIDDEN;        // O estado atual da célula (oculta, revelada ou marcada).
-};
+void seekReplay(ReplayView &view, size_t move, Game &game) {
+    move = std::min(move, view.current.moves.size());
+    if (move < view.move) {
+        replaySeek(view.current, move, game);
+    } else {
+        for (size_t i = view.move; i < move; i++) replayMove(view.current.moves[i], game);
+    }
+    view.move = move;
+}
 
 /**
- * @struct Game
- * @brief Gerencia todo o estado e a lógica do jogo Campo Minado.
+ * @brief Carrega a partida `index` do registro e a mostra do início.
+ * @return false se o registro da partida estiver corrompido.
  */
-struct Game {
-    std::vector<std::vector<Cell>> grid; // Matriz 2D que representa o tabuleiro.
-    bool gameOver = false;               // Flag que indica o fim do jogo por derrota.
-    bool youWin = false;                 // Flag que indica o fim do jogo por vitória.
-    bool firstClick = true;              // Flag para controlar a lógica especial do primeiro clique.
-
-    /**
-     * @brief Construtor da classe Game. Inicializa o grid com o tamanho definido.
-     */
-    Game() : grid(GRID_HEIGHT, std::vector<Cell>(GRID_WIDTH)) {}
-
-    /**
-     * @brief Prepara o tabuleiro para um novo jogo, resetando todas as células.
-     */
-    void initializeGrid() {
-        gameOver = false;
-        youWin = false;
-        firstClick = true; // Prepara o jogo para um novo primeiro clique.
-
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            for (int x = 0; x < GRID_WIDTH; ++x) {
-                grid[y][x] = Cell();
-            }
-        }
-    }
-
-    /**
-     * @brief Inicia o jogo a partir do primeiro clique do usuário.
-     * @details Esta função é chamada apenas uma vez por partida. Ela posiciona as minas
-     * de forma que a área do primeiro clique seja segura e, em seguida,
-     * revela a célula inicial.
-     * @param startX A coordenada X do primeiro clique.
-     * @param startY A coordenada Y do primeiro clique.
-     */
-    void startGameAt(int startX, int startY) {
-        if (!firstClick) return; // Segurança extra para garantir que só execute uma vez.
-
-        // 1. Posiciona as minas no tabuleiro.
-        int placedMines = 0;
-        while (placedMines < NUM_MINES) {
-            int x = gen_global() % GRID_WIDTH;
-            int y = gen_global() % GRID_HEIGHT;
-            // Garante que a mina não seja colocada na área 3x3 ao redor do primeiro clique.
-            bool isInSafeZone = (x >= startX - 1 && x <= startX + 1 && y >= startY - 1 && y <= startY + 1);
-            if (!grid[y][x].isMine && !isInSafeZone) {
-                grid[y][x].isMine = true;
-                placedMines++;
-            }
-        }
-
-        // 2. Calcula os números (minas vizinhas) para todas as células.
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            for (int x = 0; x < GRID_WIDTH; ++x) {
-                if (grid[y][x].isMine) continue;
-                grid[y][x].neighboringMines = 0;
-                for (int dy = -1; dy <= 1; ++dy) {
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        if (nx >= 0 && nx < GRID_WIDTH && ny >= 0 && ny < GRID_HEIGHT && grid[ny][nx].isMine) {
-                            grid[y][x].neighboringMines++;
-                        }
-                    }
-                }
-            }
-        }
-
-        firstClick = false; // Desativa a flag do primeiro clique.
-        revealCell(startX, startY); // 3. Revela a célula inicial segura.
-    }
-
-    /**
-     * @brief Revela uma célula e, se for vazia (0 minas vizinhas), revela suas vizinhas recursivamente.
-     * @param x A coordenada X da célula a ser revelada.
-     * @param y A coordenada Y da célula a ser revelada.
-     */
-    void revealCell(int x, int y) {
-        // Condições de parada: célula fora do tabuleiro ou já revelada/marcada.
-        if (x < 0 || x >= GRID_WIDTH || y < 0 || y >= GRID_HEIGHT || grid[y][x].state != HIDDEN) {
-            return;
-        }
-
-        grid[y][x].state = REVEALED;
-
-        if (grid[y][x].isMine) {
-            gameOver = true;
-            return;
-        }
-
-        // Se a célula for um '0', chama a função para todas as vizinhas.
-        if (grid[y][x].neighboringMines == 0) {
-            for (int dy = -1; dy <= 1; ++dy) {
-                for (int dx = -1; dx <= 1; ++dx) {
-                    if (dx == 0 && dy == 0) continue;
-                    revealCell(x + dx, y + dy);
-                }
-            }
-        }
-        checkWinCondition();
-    }
-
-    /**
-     * @brief Alterna o estado de uma célula entre oculta e marcada com bandeira.
-     * @param x A coordenada X da célula.
-     * @param y A coordenada Y da célula.
-     */
-    void toggleFlag(int x, int y) {
-        if (x < 0 || x >= GRID_WIDTH || y < 0 || y >= GRID_HEIGHT || grid[y][x].state == REVEALED) return;
-        if (firstClick) return; // Impede a colocação de bandeiras antes do início do jogo.
-
-        if (grid[y][x].state == HIDDEN) {
-            grid[y][x].state = FLAGGED;
-        } else if (grid[y][x].state == FLAGGED) {
-            grid[y][x].state = HIDDEN;
-        }
-    }
-
-    /**
-     * @brief Verifica se o jogador venceu a partida.
-     * @details A condição de vitória é atingida quando todas as células que não são minas
-     * foram reveladas.
-     */
-    void checkWinCondition() {
-        int revealed_count = 0;
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            for (int x = 0; x < GRID_WIDTH; ++x) {
-                if(grid[y][x].state == REVEALED) {
-                    revealed_count++;
-                }
-            }
-        }
-        // Se o número de células reveladas for igual ao total de células menos o número de minas, o jogador vence.
-        if (revealed_count == (GRID_WIDTH * GRID_HEIGHT) - NUM_MINES) {
-            youWin = true;
-        }
+bool openReplayGame(ReplayView &view, size_t index, Game &game) {
+    if (!view.reader.read(index, view.current)) {
+        std::cerr << "Erro: a partida " << index + 1 << " do registro esta corrompida." << std::endl;
+        return false;
     }
+    view.gameIndex = index;
+    replaySeek(view.current, 0, game);
+    view.move = 0;
+    return true;
+}
+
+/** @brief Título da janela no modo replay: partida, geração, cenário, jogada e resultado. */
+std::string replayTitle(const ReplayView &view) {
+    const ReplayGame &g = view.current;
+    std::string title = "Replay: partida " + std::to_string(view.gameIndex + 1) + "/" + std::to_string(view.reader.size()) +
+                        " (geracao " + std::to_string(g.generation) + ", cenario " + std::to_string(g.scenario) + ") - jogada " +
+                        std::to_string(view.move) + "/" + std::to_string(g.moves.size()) + (g.won ? " - vitoria" : " - derrota") +
+                        ", pontuacao " + std::to_string(static_cast<int>(g.score));
+    if (view.playing) title += view.stepMoves > 1 ? " [>>]" : " [>]";
+    return title;
+}
 
-    /**
-     * @brief Renderiza o estado atual do tabuleiro na tela.
-     * @param renderer O renderizador do SDL para desenhar.
-     * @param font A fonte TTF para desenhar os textos (números e 'F').
-     */
-    void render(SDL_Renderer* renderer, TTF_Font* font) {
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            for (int x = 0; x < GRID_WIDTH; ++x) {
-                SDL_Rect cellRect = {x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE};
-
-                // Desenha o fundo da célula
-                if (grid[y][x].state == REVEALED) {
-                    SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-                } else {
-                    SDL_SetRenderDrawColor(renderer, 150, 150, 150, 255);
-                }
-                SDL_RenderFillRect(renderer, &cellRect);
-
-                // Desenha o conteúdo da célula (número, mina ou bandeira)
-                if (grid[y][x].state == REVEALED) {
-                    if (grid[y][x].isMine) {
-                        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-                        SDL_RenderFillRect(renderer, &cellRect);
-                    } else if (grid[y][x].neighboringMines > 0) {
-                        SDL_Color textColor;
-                        switch (grid[y][x].neighboringMines) {
-                            case 1: textColor = {0, 0, 255}; break;
-                            case 2: textColor = {0, 128, 0}; break;
-                            case 3: textColor = {255, 0, 0}; break;
-                            default: textColor = {128, 0, 128}; break;
-                        }
-                        std::string text = std::to_string(grid[y][x].neighboringMines);
-                        SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), textColor);
-                        SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-                        SDL_Rect textRect = {cellRect.x + (CELL_SIZE - textSurface->w) / 2, cellRect.y + (CELL_SIZE - textSurface->h) / 2, textSurface->w, textSurface->h};
-                        SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-                        SDL_FreeSurface(textSurface);
-                        SDL_DestroyTexture(textTexture);
-                    }
-                } else if (grid[y][x].state == FLAGGED) {
-                    SDL_Surface* textSurface = TTF_RenderText_Solid(font, "F", {255, 0, 0});
-                    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-                    SDL_Rect textRect = {cellRect.x + (CELL_SIZE - textSurface->w) / 2, cellRect.y + (CELL_SIZE - textSurface->h) / 2, textSurface->w, textSurface->h};
-                    SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-                    SDL_FreeSurface(textSurface);
-                    SDL_DestroyTexture(textTexture);
-                }
-
-                // Desenha a borda da célula
-                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-                SDL_RenderDrawRect(renderer, &cellRect);
-            }
-        }
-
-        // Se o jogo terminou, desenha uma mensagem de vitória ou derrota
-        if (gameOver || youWin) {
-            SDL_Color color = gameOver ? SDL_Color{255, 0, 0, 128} : SDL_Color{0, 255, 0, 128};
-            std::string msg = gameOver ? "Voce Perdeu!" : "Voce Venceu!";
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-            SDL_Rect overlay = {0, WINDOW_HEIGHT / 2 - 30, WINDOW_WIDTH, 60};
-            SDL_RenderFillRect(renderer, &overlay);
-
-            SDL_Surface* textSurface = TTF_RenderText_Solid(font, msg.c_str(), {255, 255, 255});
-            SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-            SDL_Rect textRect = {(WINDOW_WIDTH - textSurface->w) / 2, (WINDOW_HEIGHT - textSurface->h) / 2, textSurface->w, textSurface->h};
-            SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-            SDL_FreeSurface(textSurface);
-            SDL_DestroyTexture(textTexture);
-        }
+/**
+ * @brief Resumo do registro no terminal: partidas, vitórias e pontuação média.
+ * @details Lê só os registros, sem aplicar nenhuma jogada.
+ */
+void printReplaySummary(const ReplayReader &reader) {
+    ReplayGame replay;
+    size_t wins = 0;
+    double totalScore = 0.0;
+    for (size_t i = 0; i < reader.size(); i++) {
+        if (!reader.read(i, replay)) continue;
+        if (replay.won) wins++;
+        totalScore += replay.score;
     }
-};
+    std::cout << reader.size() << " partidas no registro, " << wins << " vitorias";
+    if (reader.size() > 0) std::cout << ", pontuacao media " << totalScore / reader.size();
+    std::cout << "." << std::endl;
+    std::cout << "Setas esquerda/direita: jogada anterior/proxima; cima/baixo: partida anterior/proxima; "
+                 "Home/End: inicio/fim; espaco: reproduzir/pausar; F: avanco rapido." << std::endl;
+}
 
 /**
  * @brief Função principal do programa.
  * @details Inicializa o SDL, cria a janela, gerencia o loop de eventos e renderização,
  * e limpa os recursos ao final.
+ * Opções: --board=beginner|intermediate|expert, --width, --height, --mines, --config=arquivo,
+ * --replay=arquivo (o tabuleiro passa a ser o do registro).
  */
 int main(int argc, char* argv[]) {
+    // Leitura da configuração do tabuleiro
+    Options options;
+    BoardConfig board;
+    if (!options.parse(argc, argv) || !readBoardConfig(options, BoardConfig(), board)) return 1;
+
+    // Modo replay: o tabuleiro e as partidas vêm do registro.
+    const std::string replayFile = options.getString("replay", "");
+    ReplayView replay;
+    if (!replayFile.empty()) {
+        if (!replay.reader.open(replayFile)) return 1;
+        if (replay.reader.size() == 0) {
+            std::cerr << "O registro '" << replayFile << "' nao tem nenhuma partida." << std::endl;
+            return 1;
+        }
+        board = replay.reader.board();
+        printReplaySummary(replay.reader);
+    }
+
     // Inicialização das bibliotecas SDL2 e SDL2_ttf
     SDL_Init(SDL_INIT_VIDEO);
     TTF_Init();
 
     // Criação da janela e do renderizador
-    SDL_Window* window = SDL_CreateWindow("Campo Minado", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_SHOWN);
+    SDL_Window* window = SDL_CreateWindow("Campo Minado", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, board.width * CELL_SIZE, board.height * CELL_SIZE, SDL_WINDOW_SHOWN);
     SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
     
     // Carregamento da fonte (o caminho pode precisar ser ajustado)
@@ -280,57 +149,126 @@ int main(int argc, char* argv[]) {
     }
 
     // Criação e inicialização do objeto do jogo
-    Game game;
-    game.initializeGrid();
+    Game game(board.width, board.height, board.numMines);
+    if (!replayFile.empty()) {
+        if (!openReplayGame(replay, 0, game)) return 1;
+        SDL_SetWindowTitle(window, replayTitle(replay).c_str());
+    }
+
+    // Os textos são rasterizados uma única vez; a cada quadro só as casas alteradas são redesenhadas.
+    BoardTheme theme;
+    theme.cellSize = CELL_SIZE;
+    auto boardRenderer = std::make_unique<BoardRenderer>(renderer, font, theme);
 
-    // Loop principal do jogo
+    // Loop principal do jogo: dorme até o próximo evento (ou o próximo passo do replay) e
+    // só redesenha quando algo mudou.
     bool running = true;
+    bool redraw = true;
     while (running) {
+        Uint32 timeout = IDLE_TIMEOUT_MS;
+        if (replay.playing) {
+            const Uint32 elapsed = SDL_GetTicks() - replay.lastStep;
+            timeout = elapsed >= REPLAY_STEP_MS ? 0 : REPLAY_STEP_MS - elapsed;
+        }
         SDL_Event event;
         // Processamento de eventos (input do usuário)
-        while (SDL_PollEvent(&event)) {
-            // Evento de fechar a janela
-            if (event.type == SDL_QUIT) {
-                running = false;
-            }
-            // Evento de clique do mouse
-            if (event.type == SDL_MOUSEBUTTONDOWN && !game.gameOver && !game.youWin) {
-                int x = event.button.x / CELL_SIZE;
-                int y = event.button.y / CELL_SIZE;
-
-                // Lógica para o clique esquerdo (revelar)
-                if (event.button.button == SDL_BUTTON_LEFT) {
-                    // Se for o primeiro clique, inicia o jogo de forma segura
-                    if (game.firstClick) {
-                        game.startGameAt(x, y);
-                    } else {
-                        game.revealCell(x, y);
+        if (SDL_WaitEventTimeout(&event, static_cast<int>(timeout))) {
+            do {
+                // Evento de fechar a janela
+                if (event.type == SDL_QUIT) {
+                    running = false;
+                }
+                // Janela exposta ou redimensionada, ou texturas perdidas: desenha tudo de novo.
+                if (event.type == SDL_WINDOWEVENT) redraw = true;
+                if (event.type == SDL_RENDER_TARGETS_RESET) {
+                    boardRenderer->invalidate();
+                    redraw = true;
+                }
+                // No replay, o teclado navega pelas partidas e o mouse não joga.
+                if (!replayFile.empty()) {
+                    if (event.type != SDL_KEYDOWN) continue;
+                    const size_t last = replay.current.moves.size();
+                    switch (event.key.keysym.sym) {
+                        case SDLK_RIGHT: seekReplay(replay, replay.move + 1, game); break;
+                        case SDLK_LEFT: seekReplay(replay, replay.move > 0 ? replay.move - 1 : 0, game); break;
+                        case SDLK_HOME: seekReplay(replay, 0, game); break;
+                        case SDLK_END: seekReplay(replay, last, game); break;
+                        case SDLK_DOWN:
+                            if (replay.gameIndex + 1 < replay.reader.size()) openReplayGame(replay, replay.gameIndex + 1, game);
+                            break;
+                        case SDLK_UP:
+                            if (replay.gameIndex > 0) openReplayGame(replay, replay.gameIndex - 1, game);
+                            break;
+                        case SDLK_SPACE:
+                            replay.playing = !replay.playing;
+                            replay.lastStep = SDL_GetTicks();
+                            break;
+                        case SDLK_f: replay.stepMoves = replay.stepMoves > 1 ? 1 : REPLAY_FAST_STEPS; break;
+                        default: break;
                     }
-                } 
-                // Lógica para o clique direito (marcar/desmarcar bandeira)
-                else if (event.button.button == SDL_BUTTON_RIGHT) {
-                    game.toggleFlag(x, y);
+                    SDL_SetWindowTitle(window, replayTitle(replay).c_str());
+                    redraw = true;
+                    continue;
                 }
-            }
-            // Evento de pressionar uma tecla
-            if (event.type == SDL_KEYDOWN) {
-                // Se a tecla 'R' for pressionada, reinicia o jogo.
-                if (event.key.keysym.sym == SDLK_r) {
-                    game.initializeGrid();
+                // Evento de clique do mouse
+                if (event.type == SDL_MOUSEBUTTONDOWN && !game.gameOver && !game.youWin) {
+                    int x = event.button.x / CELL_SIZE;
+                    int y = event.button.y / CELL_SIZE;
+
+                    // Lógica para o clique esquerdo (revelar)
+                    if (event.button.button == SDL_BUTTON_LEFT) {
+                        // Se for o primeiro clique, inicia o jogo de forma segura
+                        if (!game.firstMoveMade) {
+                            game.startGameAt(x, y, gen_global);
+                        } else {
+                            game.revealCell(x, y);
+                        }
+                    } 
+                    // Lógica para o clique direito (marcar/desmarcar bandeira)
+                    else if (event.button.button == SDL_BUTTON_RIGHT) {
+                        game.toggleFlag(x, y);
+                    }
+                    redraw = true;
                 }
+                // Evento de pressionar uma tecla
+                if (event.type == SDL_KEYDOWN) {
+                    // Se a tecla 'R' for pressionada, reinicia o jogo.
+                    if (event.key.keysym.sym == SDLK_r) {
+                        game.initializeGrid();
+                        redraw = true;
+                    }
+                }
+            } while (SDL_PollEvent(&event));
+        }
+
+        // Reprodução automática: ao fim da partida, passa para a próxima.
+        if (replay.playing && SDL_GetTicks() - replay.lastStep >= REPLAY_STEP_MS) {
+            replay.lastStep = SDL_GetTicks();
+            if (replay.move < replay.current.moves.size()) {
+                seekReplay(replay, replay.move + replay.stepMoves, game);
+            } else if (replay.gameIndex + 1 < replay.reader.size()) {
+                openReplayGame(replay, replay.gameIndex + 1, game);
+            } else {
+                replay.playing = false;
             }
+            SDL_SetWindowTitle(window, replayTitle(replay).c_str());
+            redraw = true;
         }
 
         // Seção de renderização do frame
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        SDL_RenderClear(renderer);
+        if (redraw) {
+            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+            SDL_RenderClear(renderer);
 
-        game.render(renderer, font); // Chama a função de renderização do jogo
+            boardRenderer->draw(game); // Desenha o tabuleiro e a mensagem de fim de jogo
 
-        SDL_RenderPresent(renderer); // Apresenta o frame desenhado na tela
+            SDL_RenderPresent(renderer); // Apresenta o frame desenhado na tela
+            redraw = false;
+        }
     }
 
     // Liberação dos recursos do SDL ao fechar o programa
+    boardRenderer.reset(); // As texturas do atlas pertencem ao renderer: liberadas antes dele.
     TTF_CloseFont(font);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);